@@ -72,8 +72,10 @@ CXX_STANDARD = -std=c++20
 CXX_VISIBILITY_FLAG = -fvisibility=hidden
 CXX_POSITION_INDEPENDENT = -fPIC
 CXX_NO_RTTI = -fno-rtti
+# Batch and asynchronous execution run requests on worker threads
+CXX_THREADS = -pthread
 
-CXXFLAGS_BASE = $(CXX_OPTIMIZATION_LEVEL) $(CXX_WARNING_FLAGS) $(CXX_STANDARD) $(CXX_VISIBILITY_FLAG) $(CXX_POSITION_INDEPENDENT) $(CXX_NO_RTTI)
+CXXFLAGS_BASE = $(CXX_OPTIMIZATION_LEVEL) $(CXX_WARNING_FLAGS) $(CXX_STANDARD) $(CXX_VISIBILITY_FLAG) $(CXX_POSITION_INDEPENDENT) $(CXX_NO_RTTI) $(CXX_THREADS)
 
 # Skip pkg-config checks for targets that don't need OSRM (allows clean/show-config without deps)
 SKIP_DEPS := $(filter clean show-config,$(MAKECMDGOALS))
@@ -108,6 +110,6 @@ ifneq ($(EXTRA_CXXFLAGS),)
 endif
 
 # LDFLAGS order: shared lib flags -> RPATH -> library search paths -> libraries -> stdlib libs
-LDFLAGS = $(LDFLAGS_SHARED) $(LDFLAGS_RPATH) -L$(OSRM_LIBDIR) $(OSRM_LDFLAGS) $(STDCPP_LIB)
+LDFLAGS = $(LDFLAGS_SHARED) $(LDFLAGS_RPATH) -L$(OSRM_LIBDIR) $(OSRM_LDFLAGS) $(STDCPP_LIB) $(CXX_THREADS)
 
 export PKG_CONFIG_PATH
@@ -1,13 +1,35 @@
 // Standard library headers
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cctype>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <exception>
+#include <functional>
 #include <filesystem>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -17,6 +39,7 @@
 #include <osrm/coordinate.hpp>
 #include <osrm/engine/api/base_parameters.hpp>
 #include <osrm/engine/api/base_result.hpp>
+#include <osrm/engine/api/flatbuffers/fbresult_generated.h>
 #include <osrm/engine/hint.hpp>
 #include <osrm/engine_config.hpp>
 #include <osrm/json_container.hpp>
@@ -30,6 +53,26 @@
 #include <osrm/tile_parameters.hpp>
 #include <osrm/trip_parameters.hpp>
 
+// SIMD intrinsics (SSE2 is part of the x86-64 baseline, other targets use the scalar code paths)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Worker threads (pthreads for stack size and CPU pinning, std::thread on Windows)
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Completion queue wakeup descriptors (eventfd on Linux, a pipe on other POSIX systems)
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // Local headers
 #include "osrmc.h"
 
@@ -52,8 +95,61 @@ struct osrmc_error final {
   std::string message;
 };
 
+// Response pool settings: up to `capacity` destructed responses are kept per thread and as many in the shared pool,
+// builders whose buffer grew beyond `max_buffer_size` bytes (0 = no limit) are released rather than kept
+struct osrmc_response_pool_limits final {
+  size_t capacity = 0;
+  size_t max_buffer_size = 0;
+};
+
 struct osrmc_response final {
   osrm::engine::api::ResultT result;
+  // Set when the FlatBuffer lives in memory of a caller-installed allocator
+  bool custom_allocator = false;
+  // Pool the response goes back to on destruct, from the OSRM instance that built it
+  osrmc_response_pool_limits pool;
+  // Table responses report hints per request coordinate: the coordinate index of every waypoint, sources followed
+  // by destinations, out of `coordinate_count` (0 = hints are reported per waypoint)
+  std::vector<size_t> waypoint_coordinates;
+  size_t coordinate_count = 0;
+};
+
+// Worker pool settings, applied when the pool of an OSRM instance is first used
+struct osrmc_worker_config final {
+  unsigned threads = 0;
+  std::vector<int> cpus;
+  size_t stack_size = 0;
+};
+
+constexpr size_t osrmc_service_count = SERVICE_TILE + 1;
+constexpr size_t osrmc_lane_count = LANE_BULK + 1;
+
+// Admission control settings; the scheduler is only active when at least one concurrency limit is set
+struct osrmc_admission_config final {
+  unsigned max_active = 0;
+  unsigned lane_limits[osrmc_lane_count] = {};
+  size_t queue_capacities[osrmc_lane_count] = {1024, 1024};
+  unsigned service_limits[osrmc_service_count] = {};
+  lane_t service_lanes[osrmc_service_count] = {
+    LANE_INTERACTIVE, LANE_INTERACTIVE, LANE_BULK, LANE_BULK, LANE_BULK, LANE_INTERACTIVE};
+  std::unordered_map<uint32_t, unsigned> tenant_weights;
+
+  bool
+  enabled() const {
+    const auto set = [](unsigned limit) { return limit > 0; };
+    return max_active > 0 || std::any_of(std::begin(lane_limits), std::end(lane_limits), set) ||
+           std::any_of(std::begin(service_limits), std::end(service_limits), set);
+  }
+};
+
+struct osrmc_config final {
+  osrm::EngineConfig engine;
+  osrmc_worker_config workers;
+  osrmc_admission_config admission;
+  bool coalesce_requests = false;
+  bool allow_large_tiled_tables = false;
+  std::optional<osrmc_allocator_t> allocator;
+  osrmc_response_pool_limits response_pool;
 };
 
 
@@ -89,6 +185,209 @@ osrmc_error_destruct(osrmc_error_t error) {
   }
 }
 
+// Container helpers
+// Grows capacity geometrically so repeated bulk appends stay amortized O(1) per element
+template<typename Container>
+static void
+osrmc_reserve_additional(Container& container, size_t count) {
+  const size_t required = container.size() + count;
+  if (required > container.capacity()) {
+    container.reserve(std::max(required, container.capacity() * 2));
+  }
+}
+
+// Coordinate kernels
+// util::Coordinate stores longitude and latitude as two int32 in OSRM fixed point (degrees * COORDINATE_PRECISION).
+// The kernels convert and validate whole arrays at once; the SSE2 and scalar paths produce identical results.
+static_assert(sizeof(osrm::util::Coordinate) == 2 * sizeof(std::int32_t), "Coordinate must be two packed int32");
+static_assert(std::is_trivially_copyable_v<osrm::util::Coordinate>, "Coordinate must be trivially copyable");
+
+constexpr double OSRMC_MAX_LONGITUDE = 180.0;
+constexpr double OSRMC_MAX_LATITUDE = 90.0;
+constexpr std::int32_t OSRMC_MAX_FIXED_LONGITUDE =
+  static_cast<std::int32_t>(OSRMC_MAX_LONGITUDE * osrm::COORDINATE_PRECISION);
+constexpr std::int32_t OSRMC_MAX_FIXED_LATITUDE =
+  static_cast<std::int32_t>(OSRMC_MAX_LATITUDE * osrm::COORDINATE_PRECISION);
+constexpr size_t OSRMC_COORDINATE_CHUNK = 1024;
+
+// Rounds half away from zero with std::lround, like the std::round of util::toFixed
+static inline std::int32_t
+osrmc_to_fixed(double degrees) {
+  return static_cast<std::int32_t>(std::lround(degrees * osrm::COORDINATE_PRECISION));
+}
+
+// Comparisons are false for NaN, so NaN input is rejected as well
+static inline bool
+osrmc_is_valid_degrees(double longitude, double latitude) {
+  return longitude >= -OSRMC_MAX_LONGITUDE && longitude <= OSRMC_MAX_LONGITUDE && latitude >= -OSRMC_MAX_LATITUDE &&
+         latitude <= OSRMC_MAX_LATITUDE;
+}
+
+static inline bool
+osrmc_is_valid_fixed(std::int32_t longitude, std::int32_t latitude) {
+  return longitude >= -OSRMC_MAX_FIXED_LONGITUDE && longitude <= OSRMC_MAX_FIXED_LONGITUDE &&
+         latitude >= -OSRMC_MAX_FIXED_LATITUDE && latitude <= OSRMC_MAX_FIXED_LATITUDE;
+}
+
+#if defined(__SSE2__)
+static inline __m128i
+osrmc_to_fixed_sse2(__m128d degrees) {
+  // Truncates and steps away from zero when the exact fraction is at least one half; adding 0.5 before truncating
+  // would round values just below one half up
+  const __m128d sign_mask = _mm_set1_pd(-0.0);
+  const __m128d scaled = _mm_mul_pd(degrees, _mm_set1_pd(osrm::COORDINATE_PRECISION));
+  const __m128d truncated = _mm_cvtepi32_pd(_mm_cvttpd_epi32(scaled));
+  const __m128d fraction = _mm_andnot_pd(sign_mask, _mm_sub_pd(scaled, truncated));
+  const __m128d step = _mm_and_pd(_mm_cmpge_pd(fraction, _mm_set1_pd(0.5)),
+                                  _mm_or_pd(_mm_set1_pd(1.0), _mm_and_pd(scaled, sign_mask)));
+  return _mm_cvttpd_epi32(_mm_add_pd(truncated, step));
+}
+#endif
+
+// The to-fixed kernels write interleaved lon,lat pairs (the util::Coordinate layout) and return the index of the
+// first invalid coordinate, or count if all coordinates are valid. A vector block containing an invalid coordinate
+// is left to the scalar loop, which pinpoints it.
+static size_t
+osrmc_coordinates_to_fixed(const double* longitudes, const double* latitudes, size_t count, std::int32_t* out) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128d min_longitude = _mm_set1_pd(-OSRMC_MAX_LONGITUDE);
+  const __m128d max_longitude = _mm_set1_pd(OSRMC_MAX_LONGITUDE);
+  const __m128d min_latitude = _mm_set1_pd(-OSRMC_MAX_LATITUDE);
+  const __m128d max_latitude = _mm_set1_pd(OSRMC_MAX_LATITUDE);
+  for (; i + 2 <= count; i += 2) {
+    const __m128d longitude = _mm_loadu_pd(longitudes + i);
+    const __m128d latitude = _mm_loadu_pd(latitudes + i);
+    const __m128d valid =
+      _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(longitude, min_longitude), _mm_cmple_pd(longitude, max_longitude)),
+                 _mm_and_pd(_mm_cmpge_pd(latitude, min_latitude), _mm_cmple_pd(latitude, max_latitude)));
+    if (_mm_movemask_pd(valid) != 0x3) {
+      break;
+    }
+    const __m128i fixed = _mm_unpacklo_epi32(osrmc_to_fixed_sse2(longitude), osrmc_to_fixed_sse2(latitude));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), fixed);
+  }
+#endif
+  for (; i < count; ++i) {
+    if (!osrmc_is_valid_degrees(longitudes[i], latitudes[i])) {
+      return i;
+    }
+    out[2 * i] = osrmc_to_fixed(longitudes[i]);
+    out[2 * i + 1] = osrmc_to_fixed(latitudes[i]);
+  }
+  return count;
+}
+
+static size_t
+osrmc_coordinates_interleaved_to_fixed(const double* lonlat, size_t count, std::int32_t* out) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128d min_coordinate = _mm_setr_pd(-OSRMC_MAX_LONGITUDE, -OSRMC_MAX_LATITUDE);
+  const __m128d max_coordinate = _mm_setr_pd(OSRMC_MAX_LONGITUDE, OSRMC_MAX_LATITUDE);
+  for (; i < count; ++i) {
+    const __m128d coordinate = _mm_loadu_pd(lonlat + 2 * i);
+    const __m128d valid =
+      _mm_and_pd(_mm_cmpge_pd(coordinate, min_coordinate), _mm_cmple_pd(coordinate, max_coordinate));
+    if (_mm_movemask_pd(valid) != 0x3) {
+      break;
+    }
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 2 * i), osrmc_to_fixed_sse2(coordinate));
+  }
+#endif
+  for (; i < count; ++i) {
+    if (!osrmc_is_valid_degrees(lonlat[2 * i], lonlat[2 * i + 1])) {
+      return i;
+    }
+    out[2 * i] = osrmc_to_fixed(lonlat[2 * i]);
+    out[2 * i + 1] = osrmc_to_fixed(lonlat[2 * i + 1]);
+  }
+  return count;
+}
+
+static size_t
+osrmc_coordinates_check_fixed(const std::int32_t* longitudes,
+                              const std::int32_t* latitudes,
+                              size_t count,
+                              std::int32_t* out) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i min_longitude = _mm_set1_epi32(-OSRMC_MAX_FIXED_LONGITUDE);
+  const __m128i max_longitude = _mm_set1_epi32(OSRMC_MAX_FIXED_LONGITUDE);
+  const __m128i min_latitude = _mm_set1_epi32(-OSRMC_MAX_FIXED_LATITUDE);
+  const __m128i max_latitude = _mm_set1_epi32(OSRMC_MAX_FIXED_LATITUDE);
+  for (; i + 4 <= count; i += 4) {
+    const __m128i longitude = _mm_loadu_si128(reinterpret_cast<const __m128i*>(longitudes + i));
+    const __m128i latitude = _mm_loadu_si128(reinterpret_cast<const __m128i*>(latitudes + i));
+    const __m128i invalid =
+      _mm_or_si128(_mm_or_si128(_mm_cmplt_epi32(longitude, min_longitude), _mm_cmpgt_epi32(longitude, max_longitude)),
+                   _mm_or_si128(_mm_cmplt_epi32(latitude, min_latitude), _mm_cmpgt_epi32(latitude, max_latitude)));
+    if (_mm_movemask_epi8(invalid) != 0) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi32(longitude, latitude));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 4), _mm_unpackhi_epi32(longitude, latitude));
+  }
+#endif
+  for (; i < count; ++i) {
+    if (!osrmc_is_valid_fixed(longitudes[i], latitudes[i])) {
+      return i;
+    }
+    out[2 * i] = longitudes[i];
+    out[2 * i + 1] = latitudes[i];
+  }
+  return count;
+}
+
+static void
+osrmc_coordinates_from_fixed(const osrm::util::Coordinate* coordinates,
+                             size_t count,
+                             double* longitudes,
+                             double* latitudes) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128d precision = _mm_set1_pd(osrm::COORDINATE_PRECISION);
+  for (; i + 2 <= count; i += 2) {
+    const __m128i fixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coordinates + i));
+    const __m128d first = _mm_div_pd(_mm_cvtepi32_pd(fixed), precision);
+    const __m128d second = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(fixed, 8)), precision);
+    _mm_storeu_pd(longitudes + i, _mm_unpacklo_pd(first, second));
+    _mm_storeu_pd(latitudes + i, _mm_unpackhi_pd(first, second));
+  }
+#endif
+  for (; i < count; ++i) {
+    longitudes[i] = static_cast<double>(static_cast<std::int32_t>(coordinates[i].lon)) / osrm::COORDINATE_PRECISION;
+    latitudes[i] = static_cast<double>(static_cast<std::int32_t>(coordinates[i].lat)) / osrm::COORDINATE_PRECISION;
+  }
+}
+
+// Appends `count` coordinates produced chunk-wise by `kernel(first, count, out)`; all-or-nothing on invalid input
+template<typename Kernel>
+static void
+osrmc_append_coordinates(osrm::engine::api::BaseParameters& params,
+                         size_t count,
+                         Kernel&& kernel,
+                         osrmc_error_t* error) {
+  auto& coordinates = params.coordinates;
+  const size_t previous_size = coordinates.size();
+  osrmc_reserve_additional(coordinates, count);
+
+  std::int32_t fixed[2 * OSRMC_COORDINATE_CHUNK];
+  for (size_t first = 0; first < count; first += OSRMC_COORDINATE_CHUNK) {
+    const size_t chunk = std::min(OSRMC_COORDINATE_CHUNK, count - first);
+    const size_t valid = kernel(first, chunk, fixed);
+    if (valid != chunk) {
+      coordinates.erase(coordinates.begin() + previous_size, coordinates.end());
+      const std::string message =
+        "Input coordinate " + std::to_string(first + valid) + " is out of range or not a number";
+      osrmc_set_error(error, "InvalidCoordinate", message.c_str());
+      return;
+    }
+    for (size_t i = 0; i < chunk; ++i) {
+      coordinates.emplace_back(osrm::util::FixedLongitude{fixed[2 * i]}, osrm::util::FixedLatitude{fixed[2 * i + 1]});
+    }
+  }
+}
+
 // Static deleter function for ABI compatibility (replaces lambda)
 static void
 osrmc_free_deleter(void* ptr) {
@@ -114,6 +413,25 @@ osrmc_transfer_flatbuffer_helper(osrmc_response* resp,
   }
   auto& builder = std::get<flatbuffers::FlatBufferBuilder>(resp->result);
 
+  // Buffers of a caller-installed allocator must go back to it, so the malloc based hand-off copies them
+  if (resp->custom_allocator) {
+    const size_t data_size = builder.GetSize();
+    auto* copied_data = static_cast<uint8_t*>(std::malloc(std::max<size_t>(data_size, 1)));
+    if (!copied_data) {
+      osrmc_set_error(error, "MemoryError", "Failed to allocate memory for FlatBuffer data");
+      *data = nullptr;
+      *size = 0;
+      *deleter = nullptr;
+      return;
+    }
+    std::memcpy(copied_data, builder.GetBufferPointer(), data_size);
+    *data = copied_data;
+    *size = data_size;
+    *deleter = osrmc_free_deleter;
+    resp->result = osrm::json::Object();
+    return;
+  }
+
   // Release buffer from builder (move semantics)
   // ReleaseRaw returns raw buffer and offset
   size_t buffer_offset = 0;
@@ -160,660 +478,4871 @@ osrmc_transfer_flatbuffer_helper(osrmc_response* resp,
   resp->result = osrm::json::Object();
 }
 
-// Service helpers
-template<typename ParamsHandle, typename ParamsType, typename ResponseHandle, typename MethodFunc>
-static ResponseHandle
-osrmc_service_helper(osrmc_osrm_t osrm,
-                     ParamsHandle params,
-                     MethodFunc method,
-                     const char* error_name,
-                     osrmc_error_t* error) try {
-  if (!osrm) {
-    osrmc_set_error(error, "InvalidArgument", "OSRM instance must not be null");
-    return nullptr;
-  }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return nullptr;
-  }
-  auto* osrm_typed = reinterpret_cast<osrm::OSRM*>(osrm);
-  auto* params_typed = reinterpret_cast<ParamsType*>(params);
-
-  // Always use FlatBuffer format
-  osrm::engine::api::ResultT result = flatbuffers::FlatBufferBuilder();
-  const auto status = method(*osrm_typed, *params_typed, result);
-
-  if (status == osrm::Status::Ok) {
-    auto* out = new osrmc_response{std::move(result)};
-    return reinterpret_cast<ResponseHandle>(out);
-  }
+// Zero-copy variant of the transfer helper: the detached buffer keeps the allocation of the builder, so the payload
+// is never copied wherever the builder placed it inside its buffer
+static void
+osrmc_detached_buffer_deleter(void* owner) {
+  delete static_cast<flatbuffers::DetachedBuffer*>(owner);
+}
 
-  // Extract error from response, fallback to generic error
-  try {
-    if (error) {
-      // Errors are returned as JSON even when format is flatbuffers
-      // Try to extract error from result if it's JSON (for error responses)
-      if (std::holds_alternative<osrm::json::Object>(result)) {
-        auto& json = std::get<osrm::json::Object>(result);
-        auto code = std::get<osrm::json::String>(json.values["code"]).value;
-        auto message = std::get<osrm::json::String>(json.values["message"]).value;
-        if (code.empty()) {
-          code = "Unknown";
-        }
-        osrmc_set_error(error, code.c_str(), message.c_str());
-      } else {
-        osrmc_set_error(error, error_name, "Request failed");
-      }
-    }
-  } catch (...) {
-    osrmc_set_error(error, error_name, "Request failed");
+static void
+osrmc_detach_flatbuffer_helper(osrmc_response* resp,
+                               uint8_t** data,
+                               size_t* size,
+                               void** owner,
+                               void (**deleter)(void*),
+                               osrmc_error_t* error) {
+  *data = nullptr;
+  *size = 0;
+  *owner = nullptr;
+  *deleter = nullptr;
+  if (!std::holds_alternative<flatbuffers::FlatBufferBuilder>(resp->result)) {
+    osrmc_set_error(error, "InvalidFormat", "Response is not in FlatBuffer format");
+    return;
   }
-  return nullptr;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-  return nullptr;
+  auto& builder = std::get<flatbuffers::FlatBufferBuilder>(resp->result);
+  auto buffer = std::make_unique<flatbuffers::DetachedBuffer>(builder.Release());
+  *data = buffer->data();
+  *size = buffer->size();
+  *owner = buffer.release();
+  *deleter = osrmc_detached_buffer_deleter;
+  resp->result = osrm::json::Object();
 }
 
-/* Config */
-
-osrmc_config_t
-osrmc_config_construct(const char* base_path, osrmc_error_t* error) try {
-  auto* out = new osrm::EngineConfig;
-
-  if (base_path) {
-    out->storage_config = osrm::StorageConfig(std::filesystem::path(base_path));
-    out->use_shared_memory = false;
-  } else {
-    out->use_shared_memory = true;
-  }
+// Hint helpers
+// Binary hints are the raw bytes of OSRM segment hints, the same bytes that OSRM base64 encodes
+static_assert(std::is_trivially_copyable_v<osrm::engine::SegmentHint>, "Segment hints must be copyable bytewise");
 
-  return reinterpret_cast<osrmc_config_t>(out);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-  return nullptr;
+static bool
+osrmc_is_valid_hint_size(size_t size) {
+  return size > 0 && size % sizeof(osrm::engine::SegmentHint) == 0;
 }
 
-void
-osrmc_config_destruct(osrmc_config_t config) {
-  if (config) {
-    delete reinterpret_cast<osrm::EngineConfig*>(config);
-  }
+static osrm::engine::Hint
+osrmc_hint_from_binary(const uint8_t* data, size_t size) {
+  osrm::engine::Hint hint;
+  hint.segment_hints.resize(size / sizeof(osrm::engine::SegmentHint));
+  std::memcpy(static_cast<void*>(hint.segment_hints.data()), data, size);
+  return hint;
 }
 
-void
-osrmc_config_set_max_locations_trip(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+// Binary size of a base64 hint string from a response, without decoding it
+static size_t
+osrmc_binary_hint_size(const flatbuffers::String* hint_base64) {
+  if (!hint_base64) {
+    return 0;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->max_locations_trip = max_locations;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return hint_base64->size() / osrm::engine::ENCODED_SEGMENT_HINT_SIZE * sizeof(osrm::engine::SegmentHint);
 }
 
-void
-osrmc_config_get_max_locations_trip(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
-  if (!out_max_locations) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
-  }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+// Decodes `size` base64 characters, a multiple of 4 without padding, into `out`. Both the URL-safe alphabet OSRM
+// writes and the standard one are accepted; hints come from the engine's own encoder, so other characters are not
+// rejected and decode as zero bits.
+static void
+osrmc_base64_decode(const char* in, size_t size, uint8_t* out) {
+  static constexpr auto values = [] {
+    std::array<uint8_t, 256> table{};
+    constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    for (size_t i = 0; i < alphabet.size(); ++i) {
+      table[static_cast<unsigned char>(alphabet[i])] = static_cast<uint8_t>(i);
+    }
+    table['+'] = table['-'] = 62;
+    table['/'] = table['_'] = 63;
+    return table;
+  }();
+  const auto value = [in](size_t i) { return static_cast<uint32_t>(values[static_cast<unsigned char>(in[i])]); };
+  for (size_t i = 0; i + 4 <= size; i += 4) {
+    const uint32_t bits = value(i) << 18 | value(i + 1) << 12 | value(i + 2) << 6 | value(i + 3);
+    *out++ = static_cast<uint8_t>(bits >> 16);
+    *out++ = static_cast<uint8_t>(bits >> 8);
+    *out++ = static_cast<uint8_t>(bits);
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_max_locations = config_typed->max_locations_trip;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_config_set_max_locations_viaroute(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
-  }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->max_locations_viaroute = max_locations;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+static_assert(sizeof(osrm::engine::SegmentHint) % 3 == 0 &&
+                osrm::engine::ENCODED_SEGMENT_HINT_SIZE == sizeof(osrm::engine::SegmentHint) / 3 * 4,
+              "Segment hints must encode to unpadded base64");
+
+// Decodes a response hint straight into the caller buffer; its segments are unpadded base64 of the raw bytes, so the
+// whole string decodes in one run
+static void
+osrmc_binary_hint_decode(const flatbuffers::String* hint_base64, uint8_t* out) {
+  const size_t segment_count = osrmc_binary_hint_size(hint_base64) / sizeof(osrm::engine::SegmentHint);
+  osrmc_base64_decode(hint_base64->data(), segment_count * osrm::engine::ENCODED_SEGMENT_HINT_SIZE, out);
 }
 
-void
-osrmc_config_get_max_locations_viaroute(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
-  if (!out_max_locations) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+// Visits the hint of every response waypoint: sources followed by destinations for table responses
+template<typename VisitFunc>
+static bool
+osrmc_response_for_each_hint(osrmc_response* resp, VisitFunc visit, osrmc_error_t* error) {
+  if (!std::holds_alternative<flatbuffers::FlatBufferBuilder>(resp->result)) {
+    osrmc_set_error(error, "InvalidFormat", "Response is not in FlatBuffer format");
+    return false;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+  const auto& builder = std::get<flatbuffers::FlatBufferBuilder>(resp->result);
+  const auto* result = osrm::engine::api::fbresult::GetFBResult(builder.GetBufferPointer());
+
+  if (resp->coordinate_count == 0) {
+    const auto visit_waypoints = [&](const auto* waypoints) {
+      if (waypoints) {
+        for (const auto* waypoint : *waypoints) {
+          visit(waypoint->hint());
+        }
+      }
+    };
+    visit_waypoints(result->waypoints());
+    return true;
+  }
+
+  // Per coordinate: the hint of the first waypoint snapped for it, none for coordinates without a waypoint
+  std::vector<const flatbuffers::String*> hints(resp->coordinate_count, nullptr);
+  size_t index = 0;
+  const auto map_waypoints = [&](const auto* waypoints) {
+    if (waypoints) {
+      for (const auto* waypoint : *waypoints) {
+        if (index < resp->waypoint_coordinates.size()) {
+          auto& hint = hints[resp->waypoint_coordinates[index]];
+          hint = hint ? hint : waypoint->hint();
+        }
+        ++index;
+      }
+    }
+  };
+  map_waypoints(result->waypoints());
+  if (const auto* table = result->table()) {
+    map_waypoints(table->destinations());
+  }
+  for (const auto* hint : hints) {
+    visit(hint);
+  }
+  return true;
+}
+
+static bool
+osrmc_response_get_hint_count_helper(osrmc_response* resp, size_t* out_count, size_t* out_size, osrmc_error_t* error) {
+  size_t count = 0;
+  size_t size = 0;
+  const bool ok = osrmc_response_for_each_hint(
+    resp,
+    [&](const flatbuffers::String* hint_base64) {
+      ++count;
+      size += osrmc_binary_hint_size(hint_base64);
+    },
+    error);
+  if (ok) {
+    *out_count = count;
+    *out_size = size;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_max_locations = config_typed->max_locations_viaroute;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return ok;
 }
 
-void
-osrmc_config_set_max_locations_distance_table(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+static void
+osrmc_response_get_hints_helper(osrmc_response* resp,
+                                uint8_t* out_data,
+                                size_t capacity,
+                                size_t* out_sizes,
+                                size_t count,
+                                osrmc_error_t* error) {
+  size_t waypoint_count = 0;
+  size_t size = 0;
+  if (!osrmc_response_get_hint_count_helper(resp, &waypoint_count, &size, error)) {
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->max_locations_distance_table = max_locations;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
-
-void
-osrmc_config_get_max_locations_distance_table(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
-  if (!out_max_locations) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+  if (count != waypoint_count) {
+    osrmc_set_error(error, "InvalidArgument", "Count must match waypoint count");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (size > capacity || (size > 0 && !out_data) || (count > 0 && !out_sizes)) {
+    osrmc_set_error(error, "InvalidArgument", "Output buffer too small");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_max_locations = config_typed->max_locations_distance_table;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+
+  size_t index = 0;
+  size_t offset = 0;
+  osrmc_response_for_each_hint(
+    resp,
+    [&](const flatbuffers::String* hint_base64) {
+      const size_t hint_size = osrmc_binary_hint_size(hint_base64);
+      osrmc_binary_hint_decode(hint_base64, out_data + offset);
+      out_sizes[index++] = hint_size;
+      offset += hint_size;
+    },
+    error);
 }
 
-void
-osrmc_config_set_max_locations_map_matching(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+// Worker pool
+// Work-stealing pool: every worker owns a deque, runs its own tasks newest first and steals the oldest tasks of
+// other workers when it runs dry. Tasks submitted from outside the pool are spread round-robin; tasks submitted
+// from a worker stay on that worker's deque.
+class osrmc_worker_pool final {
+public:
+  // `owner` tags the threads of the pool, see is_worker_of()
+  osrmc_worker_pool(const osrmc_worker_config& config, const void* owner) : owner_(owner) {
+    const unsigned thread_count =
+      config.threads > 0 ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; ++i) {
+      workers_.push_back(std::make_unique<worker>());
+      workers_.back()->pool = this;
+      workers_.back()->index = i;
+    }
+    // A worker that fails to start keeps its deque; the others steal from it
+    size_t started = 0;
+    for (unsigned i = 0; i < thread_count; ++i) {
+      const int cpu = config.cpus.empty() ? -1 : config.cpus[i % config.cpus.size()];
+      started += start(*workers_[i], config.stack_size, cpu) ? 1 : 0;
+    }
+    if (started == 0) {
+      throw std::runtime_error("Failed to start worker threads");
+    }
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->max_locations_map_matching = max_locations;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_config_get_max_locations_map_matching(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
-  if (!out_max_locations) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+  ~osrmc_worker_pool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& w : workers_) {
+      join(*w);
+    }
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+
+  osrmc_worker_pool(const osrmc_worker_pool&) = delete;
+  osrmc_worker_pool& operator=(const osrmc_worker_pool&) = delete;
+
+  size_t
+  size() const {
+    return workers_.size();
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_max_locations = config_typed->max_locations_map_matching;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_config_set_max_radius_map_matching(osrmc_config_t config, double max_radius, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+  // True on the worker threads of the pool started for `owner`
+  static bool
+  is_worker_of(const void* owner) {
+    return current_pool && current_pool->owner_ == owner;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->max_radius_map_matching = max_radius;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_config_get_max_radius_map_matching(osrmc_config_t config, double* out_max_radius, osrmc_error_t* error) try {
-  if (!out_max_radius) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+  // Queues a task; tasks must not throw and still queued tasks run before the pool is destroyed
+  void
+  submit(std::function<void()> task) {
+    const size_t target = current_pool == this ? current_index
+                                               : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    // Counted before it is published, so a worker that pops it right away never takes the count below zero
+    queued_.fetch_add(1, std::memory_order_release);
+    try {
+      std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+      workers_[target]->tasks.push_back(std::move(task));
+    } catch (...) {
+      queued_.fetch_sub(1, std::memory_order_release);
+      throw;
+    }
+    // Pairs with the predicate check in run() so a worker going to sleep cannot miss the task. Notifying under the
+    // lock keeps the pool alive until then, as a task may destroy its instance as soon as it runs.
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    wake_.notify_one();
+  }
+
+private:
+  struct worker final {
+    osrmc_worker_pool* pool = nullptr;
+    size_t index = 0;
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+    bool started = false;
+#if defined(_WIN32)
+    std::thread thread;
+#else
+    pthread_t thread;
+#endif
+  };
+
+#if defined(_WIN32)
+  // Stack size and CPU pinning are not applied on Windows
+  static bool
+  start(worker& w, size_t, int) try {
+    w.thread = std::thread([&w] { w.pool->run(w.index); });
+    w.started = true;
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  static void
+  join(worker& w) {
+    if (w.started) {
+      w.thread.join();
+    }
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+#else
+  static void*
+  entry(void* argument) {
+    auto* w = static_cast<worker*>(argument);
+    w->pool->run(w->index);
+    return nullptr;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_max_radius = config_typed->max_radius_map_matching;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_config_set_max_results_nearest(osrmc_config_t config, int max_results, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return;
+  // CPU pinning is applied on Linux only
+  static bool
+  start(worker& w, size_t stack_size, [[maybe_unused]] int cpu) {
+    pthread_attr_t attributes;
+    if (pthread_attr_init(&attributes) != 0) {
+      return false;
+    }
+    if (stack_size > 0) {
+      pthread_attr_setstacksize(&attributes, std::max<size_t>(stack_size, PTHREAD_STACK_MIN));
+    }
+#if defined(__linux__)
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(cpu, &cpus);
+      pthread_attr_setaffinity_np(&attributes, sizeof(cpus), &cpus);
+    }
+#endif
+    w.started = pthread_create(&w.thread, &attributes, entry, &w) == 0;
+    pthread_attr_destroy(&attributes);
+    return w.started;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->max_results_nearest = max_results;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
+  static void
+  join(worker& w) {
+    if (w.started) {
+      pthread_join(w.thread, nullptr);
+    }
+  }
+#endif
+
+  bool
+  pop(size_t self, std::function<void()>& task) {
+    {
+      auto& own = *workers_[self];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+      auto& victim = *workers_[(self + offset) % workers_.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void
+  run(size_t self) {
+    current_pool = this;
+    current_index = self;
+    std::function<void()> task;
+    while (true) {
+      if (pop(self, task)) {
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
+        try {
+          task();
+        } catch (...) {
+          // Tasks report their own errors, never let one take down the worker
+        }
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [this] { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+      if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<worker>> workers_;
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> next_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+  const void* const owner_;
+
+  static thread_local osrmc_worker_pool* current_pool;
+  static thread_local size_t current_index;
+};
+
+thread_local osrmc_worker_pool* osrmc_worker_pool::current_pool = nullptr;
+thread_local size_t osrmc_worker_pool::current_index = 0;
+
+// Admission control
+// Requests are granted an engine slot while the instance, lane and service concurrency limits allow it, otherwise
+// they wait in a bounded per-lane queue. Freed slots go to the interactive lane first. Within a lane, tenants are
+// served by start-time fair queuing with unit cost per request: each queued request is tagged with a virtual finish
+// time of max(lane time, tenant finish) + 1 / weight and the smallest eligible tag goes next, so backlogged tenants
+// share a lane in proportion to their weights.
+class osrmc_scheduler final {
+public:
+  // Runs once the request holds a slot, outside the scheduler lock; must not throw
+  using start_func = std::function<void()>;
+
+  explicit osrmc_scheduler(const osrmc_admission_config& config) : config_(config), enabled_(config.enabled()) {}
+
+  osrmc_scheduler(const osrmc_scheduler&) = delete;
+  osrmc_scheduler& operator=(const osrmc_scheduler&) = delete;
+
+  bool
+  enabled() const {
+    return enabled_;
+  }
+
+  // Starts the request now or queues it; returns false when the lane queue is full. `out_id` identifies a queued
+  // request for withdraw().
+  bool
+  admit(service_type_t service, uint32_t tenant, start_func start, uint64_t* out_id) {
+    const lane_t lane = config_.service_lanes[service];
+    std::vector<start_func> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = lanes_[lane];
+      if (startable(service)) {
+        acquire(service);
+        *out_id = 0;
+        ready.push_back(std::move(start));
+      } else {
+        if (queue.queued >= config_.queue_capacities[lane]) {
+          return false;
+        }
+        auto& tenant_queue = queue.tenants[tenant];
+        const double start_tag = std::max(queue.virtual_time, tenant_queue.finish);
+        tenant_queue.finish = start_tag + 1.0 / weight(tenant);
+        *out_id = ++last_id_;
+        tenant_queue.waiting.push_back(waiter{*out_id, service, start_tag, tenant_queue.finish, std::move(start)});
+        ++queue.queued;
+        dispatch(ready);
+      }
+    }
+    for (auto& func : ready) {
+      func();
+    }
+    return true;
+  }
+
+  // Takes a slot if a request for `service` would start right away, without queueing otherwise
+  bool
+  try_acquire(service_type_t service) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!startable(service)) {
+      return false;
+    }
+    acquire(service);
+    return true;
+  }
+
+  // Removes a queued request; returns false if it has already been started
+  bool
+  withdraw(service_type_t service, uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& queue = lanes_[config_.service_lanes[service]];
+    for (auto& [tenant, tenant_queue] : queue.tenants) {
+      const auto found = std::find_if(tenant_queue.waiting.begin(), tenant_queue.waiting.end(), [id](const auto& w) {
+        return w.id == id;
+      });
+      if (found != tenant_queue.waiting.end()) {
+        tenant_queue.waiting.erase(found);
+        --queue.queued;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns the slot of a finished request and starts whatever it unblocks
+  void
+  release(service_type_t service) {
+    std::vector<start_func> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --active_;
+      --lane_active_[config_.service_lanes[service]];
+      --service_active_[service];
+      dispatch(ready);
+    }
+    for (auto& func : ready) {
+      func();
+    }
+  }
+
+private:
+  struct waiter final {
+    uint64_t id;
+    service_type_t service;
+    double start_tag;
+    double finish_tag;
+    start_func start;
+  };
+
+  struct tenant_queue final {
+    std::deque<waiter> waiting;
+    double finish = 0;
+  };
+
+  struct lane_queue final {
+    std::unordered_map<uint32_t, tenant_queue> tenants;
+    size_t queued = 0;
+    double virtual_time = 0;
+  };
+
+  double
+  weight(uint32_t tenant) const {
+    const auto found = config_.tenant_weights.find(tenant);
+    return found == config_.tenant_weights.end() ? 1.0 : static_cast<double>(found->second);
+  }
+
+  bool
+  available(service_type_t service) const {
+    const auto below = [](size_t active, unsigned limit) { return limit == 0 || active < limit; };
+    const lane_t lane = config_.service_lanes[service];
+    return below(active_, config_.max_active) && below(lane_active_[lane], config_.lane_limits[lane]) &&
+           below(service_active_[service], config_.service_limits[service]);
+  }
+
+  // Nothing queued ahead of the request and a slot free for it
+  bool
+  startable(service_type_t service) const {
+    const lane_t lane = config_.service_lanes[service];
+    return lanes_[lane].queued == 0 && (lane == LANE_INTERACTIVE || lanes_[LANE_INTERACTIVE].queued == 0) &&
+           available(service);
+  }
+
+  void
+  acquire(service_type_t service) {
+    ++active_;
+    ++lane_active_[config_.service_lanes[service]];
+    ++service_active_[service];
+  }
+
+  // Grants slots to queued requests, interactive lane first, and collects their start functions
+  void
+  dispatch(std::vector<start_func>& ready) {
+    bool granted = true;
+    while (granted) {
+      granted = false;
+      for (auto& queue : lanes_) {
+        tenant_queue* next = nullptr;
+        for (auto& [tenant, candidate] : queue.tenants) {
+          if (!candidate.waiting.empty() && available(candidate.waiting.front().service) &&
+              (!next || candidate.waiting.front().finish_tag < next->waiting.front().finish_tag)) {
+            next = &candidate;
+          }
+        }
+        if (!next) {
+          continue;
+        }
+        auto& head = next->waiting.front();
+        acquire(head.service);
+        queue.virtual_time = head.start_tag;
+        ready.push_back(std::move(head.start));
+        next->waiting.pop_front();
+        --queue.queued;
+        // Idle tenants that are not ahead of the lane keep no state
+        for (auto it = queue.tenants.begin(); it != queue.tenants.end();) {
+          it = it->second.waiting.empty() && it->second.finish <= queue.virtual_time ? queue.tenants.erase(it)
+                                                                                        : std::next(it);
+        }
+        granted = true;
+        break;
+      }
+    }
+  }
+
+  const osrmc_admission_config config_;
+  const bool enabled_;
+  std::mutex mutex_;
+  lane_queue lanes_[osrmc_lane_count];
+  size_t active_ = 0;
+  size_t lane_active_[osrmc_lane_count] = {};
+  size_t service_active_[osrmc_service_count] = {};
+  uint64_t last_id_ = 0;
+};
+
+// Request coalescing
+// Identical requests that overlap in time share one engine call: the first caller runs it, callers arriving while
+// it is in flight wait and receive a copy of its result. Finished FlatBuffers are copied with a single memcpy.
+// FlatBuffers are copied into the builder `target` already holds, so the copy uses that builder's allocator
+static void
+osrmc_copy_result(osrm::Status status, const osrm::engine::api::ResultT& source, osrm::engine::api::ResultT& target) {
+  if (const auto* json = std::get_if<osrm::json::Object>(&source)) {
+    target = *json;
+    return;
+  }
+  if (const auto* tile = std::get_if<std::string>(&source)) {
+    target = *tile;
+    return;
+  }
+  if (!std::holds_alternative<flatbuffers::FlatBufferBuilder>(target)) {
+    target = flatbuffers::FlatBufferBuilder();
+  }
+  if (status == osrm::Status::Ok) {
+    const auto& builder = std::get<flatbuffers::FlatBufferBuilder>(source);
+    std::get<flatbuffers::FlatBufferBuilder>(target).PushFlatBuffer(builder.GetBufferPointer(), builder.GetSize());
+  }
+}
+
+class osrmc_singleflight final {
+public:
+  explicit osrmc_singleflight(bool enabled) : enabled_(enabled) {}
+
+  osrmc_singleflight(const osrmc_singleflight&) = delete;
+  osrmc_singleflight& operator=(const osrmc_singleflight&) = delete;
+
+  bool
+  enabled() const {
+    return enabled_;
+  }
+
+  // Runs `execute(result)` or joins an identical request in flight. `execute` returns the engine status, or nullopt
+  // with `error` set when the request never reached the engine; callers waiting on it then retry on their own.
+  // `stop(error)` is polled while waiting and returns true, with `error` set, when the caller gives up.
+  template<typename ExecuteFunc, typename StopFunc>
+  std::optional<osrm::Status>
+  run(const std::string& key,
+      ExecuteFunc execute,
+      StopFunc stop,
+      osrm::engine::api::ResultT& result,
+      osrmc_error_t* error) {
+    while (true) {
+      std::shared_ptr<flight> current;
+      bool leader = false;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = flights_[key];
+        if (!entry) {
+          entry = std::make_shared<flight>();
+          leader = true;
+        } else {
+          ++entry->followers;
+        }
+        current = entry;
+      }
+
+      if (leader) {
+        std::optional<osrm::Status> status;
+        try {
+          status = execute(result);
+        } catch (...) {
+          finish(key, *current, std::nullopt, result);
+          throw;
+        }
+        finish(key, *current, status, result);
+        return status;
+      }
+
+      std::unique_lock<std::mutex> lock(current->mutex);
+      while (!current->finished.wait_for(lock, std::chrono::milliseconds(5), [&current] { return current->done; })) {
+        if (stop(error)) {
+          return std::nullopt;
+        }
+      }
+      if (current->status) {
+        osrmc_copy_result(*current->status, current->result, result);
+        return current->status;
+      }
+    }
+  }
+
+private:
+  struct flight final {
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    size_t followers = 0;
+    std::optional<osrm::Status> status;
+    osrm::engine::api::ResultT result;
+  };
+
+  // Unpublishes the flight, so later callers start a new one, and hands the result to the callers already waiting
+  void
+  finish(const std::string& key,
+         flight& current,
+         std::optional<osrm::Status> status,
+         const osrm::engine::api::ResultT& result) {
+    size_t followers = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flights_.erase(key);
+      followers = current.followers;
+    }
+    {
+      std::lock_guard<std::mutex> lock(current.mutex);
+      if (followers > 0 && status) {
+        osrmc_copy_result(*status, result, current.result);
+        current.status = status;
+      }
+      current.done = true;
+    }
+    current.finished.notify_all();
+  }
+
+  const bool enabled_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<flight>> flights_;
+};
+
+// Response pools
+// Destructed responses are kept on the destructing thread together with their cleared builder, so the next
+// response built on that thread serializes into an already grown buffer. A thread that already keeps `capacity` of
+// them passes further ones to a pool shared by all threads, which threads with none of their own draw from: responses
+// built on pool workers and destructed on the caller thread find their way back to the workers that way. Responses
+// of caller-installed allocators are never pooled.
+// Pools are shared by all instances, so a taken response is trimmed to the limits of the instance taking it. Once
+// the last instance that pools responses is destroyed, the shared pool is emptied and every thread empties its own
+// on its next use of it.
+class osrmc_response_pool final {
+public:
+  // Registers an instance that pools responses
+  static void
+  attach() {
+    shared().users.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static void
+  detach() {
+    auto& spill = shared();
+    response_list released;
+    {
+      std::lock_guard<std::mutex> lock(spill.mutex);
+      if (spill.users.fetch_sub(1, std::memory_order_relaxed) != 1) {
+        return;
+      }
+      released.swap(spill.responses);
+      spill.generation.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  static std::unique_ptr<osrmc_response>
+  acquire(const osrmc_response_pool_limits& limits) {
+    auto response = take();
+    if (!response) {
+      return std::make_unique<osrmc_response>();
+    }
+    if (!fits(*response, limits)) {
+      response->result = flatbuffers::FlatBufferBuilder();
+    }
+    return response;
+  }
+
+  static void
+  recycle(std::unique_ptr<osrmc_response> response) {
+    const auto limits = response->pool;
+    auto& spill = shared();
+    if (response->custom_allocator || limits.capacity == 0 || spill.users.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    response->waypoint_coordinates.clear();
+    response->coordinate_count = 0;
+    if (fits(*response, limits)) {
+      std::get<flatbuffers::FlatBufferBuilder>(response->result).Clear();
+    } else {
+      response->result = flatbuffers::FlatBufferBuilder();
+    }
+    auto& own = local();
+    if (own.size() < limits.capacity) {
+      own.push_back(std::move(response));
+      return;
+    }
+    std::lock_guard<std::mutex> lock(spill.mutex);
+    if (spill.responses.size() < limits.capacity) {
+      spill.responses.push_back(std::move(response));
+    }
+  }
+
+private:
+  using response_list = std::vector<std::unique_ptr<osrmc_response>>;
+
+  struct spill_pool final {
+    std::mutex mutex;
+    response_list responses;
+    std::atomic<size_t> users{0};
+    std::atomic<uint64_t> generation{0};
+  };
+
+  struct local_pool final {
+    response_list responses;
+    uint64_t generation = 0;
+  };
+
+  static spill_pool&
+  shared() {
+    static spill_pool pool;
+    return pool;
+  }
+
+  // The pool of the calling thread, emptied first if the pools were released since its last use
+  static response_list&
+  local() {
+    static thread_local local_pool pool;
+    const auto generation = shared().generation.load(std::memory_order_acquire);
+    if (pool.generation != generation) {
+      pool.responses.clear();
+      pool.generation = generation;
+    }
+    return pool.responses;
+  }
+
+  static std::unique_ptr<osrmc_response>
+  take() {
+    auto& own = local();
+    if (!own.empty()) {
+      return pop(own);
+    }
+    auto& spill = shared();
+    std::lock_guard<std::mutex> lock(spill.mutex);
+    return spill.responses.empty() ? nullptr : pop(spill.responses);
+  }
+
+  static std::unique_ptr<osrmc_response>
+  pop(response_list& responses) {
+    auto response = std::move(responses.back());
+    responses.pop_back();
+    return response;
+  }
+
+  // Whether the builder of `response` may be kept; trimmed by the memory it holds, which outgrows the last response
+  // it served
+  static bool
+  fits(const osrmc_response& response, const osrmc_response_pool_limits& limits) {
+    const auto* builder = std::get_if<flatbuffers::FlatBufferBuilder>(&response.result);
+    return builder && (limits.max_buffer_size == 0 || builder->GetBufferCapacity() <= limits.max_buffer_size);
+  }
+};
+
+// The pool is started on first use, so instances that only serve blocking calls run no extra threads
+struct osrmc_osrm final {
+  explicit osrmc_osrm(osrmc_config& config)
+    : engine(config.engine),
+      max_table_locations(config.engine.max_locations_distance_table),
+      allow_large_tiled_tables(config.allow_large_tiled_tables),
+      workers(config.workers),
+      scheduler(config.admission),
+      flights(config.coalesce_requests),
+      allocator(config.allocator),
+      response_pool(config.response_pool) {
+    if (response_pool.capacity > 0) {
+      osrmc_response_pool::attach();
+    }
+  }
+
+  ~osrmc_osrm() {
+    // Workers may still recycle responses until the pool has stopped
+    pool_instance.reset();
+    if (response_pool.capacity > 0) {
+      osrmc_response_pool::detach();
+    }
+  }
+
+  osrmc_osrm(const osrmc_osrm&) = delete;
+  osrmc_osrm& operator=(const osrmc_osrm&) = delete;
+
+  osrmc_worker_pool&
+  pool() {
+    std::call_once(pool_once, [this] { pool_instance = std::make_unique<osrmc_worker_pool>(workers, this); });
+    return *pool_instance;
+  }
+
+  osrm::OSRM engine;
+  const int max_table_locations;
+  const bool allow_large_tiled_tables;
+  osrmc_worker_config workers;
+  osrmc_scheduler scheduler;
+  osrmc_singleflight flights;
+  const std::optional<osrmc_allocator_t> allocator;
+  const osrmc_response_pool_limits response_pool;
+  std::once_flag pool_once;
+  // Declared last so queued tasks finish before the engine is destroyed
+  std::unique_ptr<osrmc_worker_pool> pool_instance;
+};
+
+// Batch helpers
+// Runs func(0) .. func(n - 1) on the pool, on at most `width` threads counting the caller. The calling thread claims
+// items as well, so the call completes even when it is made from a pool worker or no pool is available. `func` must
+// not throw.
+template<typename Func>
+static void
+osrmc_parallel_for(osrmc_worker_pool* pool, size_t n, Func func, size_t width = std::numeric_limits<size_t>::max()) {
+  struct progress final {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+  // Shared with helper tasks that may only start after all items are claimed; those never touch `func`
+  const auto state = std::make_shared<progress>();
+  const auto work = [state, n, &func] {
+    size_t count = 0;
+    for (size_t i = state->next.fetch_add(1, std::memory_order_relaxed); i < n;
+         i = state->next.fetch_add(1, std::memory_order_relaxed)) {
+      func(i);
+      ++count;
+    }
+    if (count > 0 && state->done.fetch_add(count, std::memory_order_acq_rel) + count == n) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->finished.notify_all();
+    }
+  };
+
+  const size_t helpers = pool && n > 1 && width > 1 ? std::min({n - 1, pool->size(), width - 1}) : 0;
+  try {
+    for (size_t i = 0; i < helpers; ++i) {
+      pool->submit(work);
+    }
+  } catch (const std::exception&) {
+    // Continue with the helpers that were queued
+  }
+  work();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock, [&] { return state->done.load(std::memory_order_acquire) == n; });
+}
+
+static osrmc_worker_pool*
+osrmc_pool_or_null(osrmc_osrm_t osrm) {
+  if (!osrm) {
+    return nullptr;
+  }
+  try {
+    return &osrm->pool();
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+}
+
+// Request controls
+// Params handles are OSRM parameter objects. Each one is allocated behind its own controls block, so deadlines,
+// tokens and the other per-request controls are found from the handle alone, without shared state.
+struct osrmc_cancel_token final {
+  std::atomic<bool> cancelled{false};
+  std::atomic<unsigned> references{1};
+};
+
+static void
+osrmc_cancel_token_release(osrmc_cancel_token* token) {
+  if (token && token->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete token;
+  }
+}
+
+struct osrmc_request_controls final {
+  int64_t deadline_ms = 0;
+  osrmc_cancel_token* token = nullptr;
+  uint32_t tenant = 0;
+  // Table block size of tiled execution, 0 = untiled
+  size_t tile_rows = 0;
+  size_t tile_cols = 0;
+  std::optional<osrmc_allocator_t> allocator;
+};
+
+// Offset of a params object behind its controls, aligned for any params type
+constexpr size_t osrmc_controls_offset =
+  (sizeof(osrmc_request_controls) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+  alignof(std::max_align_t);
+
+// Controls of a params handle; also valid for the BaseParameters view of a handle, which has the same address
+static osrmc_request_controls&
+osrmc_params_controls(const void* params) {
+  auto* bytes = static_cast<unsigned char*>(const_cast<void*>(params)) - osrmc_controls_offset;
+  return *std::launder(reinterpret_cast<osrmc_request_controls*>(bytes));
+}
+
+// Every params object that becomes a handle is created and destroyed through these
+template<typename ParamsType, typename... Args>
+static ParamsType*
+osrmc_new_params(Args&&... args) {
+  static_assert(alignof(ParamsType) <= alignof(std::max_align_t), "Params must fit the controls alignment");
+  auto* bytes = static_cast<unsigned char*>(::operator new(osrmc_controls_offset + sizeof(ParamsType)));
+  auto* controls = new (bytes) osrmc_request_controls();
+  try {
+    return new (bytes + osrmc_controls_offset) ParamsType(std::forward<Args>(args)...);
+  } catch (...) {
+    controls->~osrmc_request_controls();
+    ::operator delete(bytes);
+    throw;
+  }
+}
+
+static void
+osrmc_erase_controls(const void* params);
+
+template<typename ParamsType>
+static void
+osrmc_delete_params(ParamsType* params) {
+  osrmc_erase_controls(params);
+  auto& controls = osrmc_params_controls(params);
+  params->~ParamsType();
+  controls.~osrmc_request_controls();
+  ::operator delete(static_cast<void*>(&controls));
+}
+
+struct osrmc_params_deleter final {
+  template<typename ParamsType>
+  void
+  operator()(ParamsType* params) const {
+    osrmc_delete_params(params);
+  }
+};
+
+template<typename ParamsType>
+using osrmc_params_ptr = std::unique_ptr<ParamsType, osrmc_params_deleter>;
+
+static int64_t
+osrmc_steady_now_ms() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+// Controls follow the params object they belong to: setting them while a request with the same params is running
+// is a data race, just like setting any other parameter
+template<typename UpdateFunc>
+static void
+osrmc_update_controls(const void* params, UpdateFunc update) {
+  update(osrmc_params_controls(params));
+}
+
+// Resets the controls of `params` to the defaults
+static void
+osrmc_erase_controls(const void* params) {
+  auto& controls = osrmc_params_controls(params);
+  osrmc_cancel_token_release(std::exchange(controls, osrmc_request_controls()).token);
+}
+
+template<typename ReadFunc>
+static auto
+osrmc_read_controls(const void* params, ReadFunc read) {
+  return read(std::as_const(osrmc_params_controls(params)));
+}
+
+static uint32_t
+osrmc_controls_tenant(const void* params) {
+  return osrmc_read_controls(params, [](const osrmc_request_controls& controls) { return controls.tenant; });
+}
+
+// Reports Cancelled or Timeout and returns false once the request of `params` should stop
+static bool
+osrmc_check_controls(const void* params, osrmc_error_t* error) {
+  const auto& controls = osrmc_params_controls(params);
+  if (controls.token && controls.token->cancelled.load(std::memory_order_acquire)) {
+    osrmc_set_error(error, "Cancelled", "Request was cancelled");
+    return false;
+  }
+  if (controls.deadline_ms > 0 && osrmc_steady_now_ms() >= controls.deadline_ms) {
+    osrmc_set_error(error, "Timeout", "Request deadline exceeded");
+    return false;
+  }
+  return true;
+}
+
+// Request keys
+// Serializes every field that influences the engine result, so two params objects get the same key exactly when
+// they describe the same request. Values are appended bytewise behind length prefixes and presence flags; floating
+// point fields that compare equal but differ in representation (0.0 and -0.0) only cost a missed coalescing.
+class osrmc_request_key final {
+public:
+  explicit osrmc_request_key(service_type_t service) {
+    add(service);
+  }
+
+  template<typename T>
+  void
+  add(const T& value) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+      key_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    } else {
+      add_object(value);
+    }
+  }
+
+  template<typename... Members, typename ParamsType>
+  void
+  add_members(const ParamsType& params, Members... members) {
+    (add(params.*members), ...);
+  }
+
+  const std::string&
+  str() const {
+    return key_;
+  }
+
+private:
+  void
+  add_object(const std::string& value) {
+    add(value.size());
+    key_.append(value);
+  }
+
+  void
+  add_object(const osrm::util::Coordinate& value) {
+    add(static_cast<std::int32_t>(value.lon));
+    add(static_cast<std::int32_t>(value.lat));
+  }
+
+  void
+  add_object(const osrm::Bearing& value) {
+    add(value.bearing);
+    add(value.range);
+  }
+
+  void
+  add_object(const osrm::engine::Hint& value) {
+    add(value.segment_hints.size());
+    key_.append(reinterpret_cast<const char*>(value.segment_hints.data()),
+                value.segment_hints.size() * sizeof(osrm::engine::SegmentHint));
+  }
+
+  template<typename T>
+  void
+  add_object(const std::optional<T>& value) {
+    add(value.has_value());
+    if (value) {
+      add(*value);
+    }
+  }
+
+  template<typename T>
+  void
+  add_object(const std::vector<T>& values) {
+    add(values.size());
+    if constexpr (std::is_arithmetic_v<T>) {
+      key_.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    } else {
+      for (const auto& value : values) {
+        add(value);
+      }
+    }
+  }
+
+  std::string key_;
+};
+
+static void
+osrmc_add_key_fields(osrmc_request_key& key, const osrm::engine::api::BaseParameters& params) {
+  using osrm::engine::api::BaseParameters;
+  key.add_members(params,
+                  &BaseParameters::coordinates,
+                  &BaseParameters::hints,
+                  &BaseParameters::radiuses,
+                  &BaseParameters::bearings,
+                  &BaseParameters::approaches,
+                  &BaseParameters::exclude,
+                  &BaseParameters::format,
+                  &BaseParameters::generate_hints,
+                  &BaseParameters::skip_waypoints,
+                  &BaseParameters::snapping);
+}
+
+static void
+osrmc_add_key_fields(osrmc_request_key& key, const osrm::RouteParameters& params) {
+  using osrm::RouteParameters;
+  osrmc_add_key_fields(key, static_cast<const osrm::engine::api::BaseParameters&>(params));
+  key.add_members(params,
+                  &RouteParameters::steps,
+                  &RouteParameters::alternatives,
+                  &RouteParameters::number_of_alternatives,
+                  &RouteParameters::annotations,
+                  &RouteParameters::annotations_type,
+                  &RouteParameters::geometries,
+                  &RouteParameters::overview,
+                  &RouteParameters::continue_straight,
+                  &RouteParameters::waypoints);
+}
+
+static void
+osrmc_add_key_fields(osrmc_request_key& key, const osrm::NearestParameters& params) {
+  osrmc_add_key_fields(key, static_cast<const osrm::engine::api::BaseParameters&>(params));
+  key.add(params.number_of_results);
+}
+
+static void
+osrmc_add_key_fields(osrmc_request_key& key, const osrm::TableParameters& params) {
+  using osrm::TableParameters;
+  osrmc_add_key_fields(key, static_cast<const osrm::engine::api::BaseParameters&>(params));
+  key.add_members(params,
+                  &TableParameters::sources,
+                  &TableParameters::destinations,
+                  &TableParameters::fallback_speed,
+                  &TableParameters::fallback_coordinate_type,
+                  &TableParameters::annotations,
+                  &TableParameters::scale_factor);
+}
+
+static void
+osrmc_add_key_fields(osrmc_request_key& key, const osrm::MatchParameters& params) {
+  using osrm::MatchParameters;
+  osrmc_add_key_fields(key, static_cast<const osrm::RouteParameters&>(params));
+  key.add_members(params, &MatchParameters::timestamps, &MatchParameters::gaps, &MatchParameters::tidy);
+}
+
+static void
+osrmc_add_key_fields(osrmc_request_key& key, const osrm::TripParameters& params) {
+  using osrm::TripParameters;
+  osrmc_add_key_fields(key, static_cast<const osrm::RouteParameters&>(params));
+  key.add_members(params, &TripParameters::source, &TripParameters::destination, &TripParameters::roundtrip);
+}
+
+static void
+osrmc_add_key_fields(osrmc_request_key& key, const osrm::TileParameters& params) {
+  key.add_members(params, &osrm::TileParameters::x, &osrm::TileParameters::y, &osrm::TileParameters::z);
+}
+
+// Admission helpers
+// Set by a pool task that was granted its slot before it was queued; the service call it makes consumes the flag
+// instead of queueing a second time
+static thread_local bool osrmc_slot_granted = false;
+
+class osrmc_slot final {
+public:
+  osrmc_slot(osrmc_scheduler& scheduler, service_type_t service) : scheduler_(scheduler), service_(service) {}
+  ~osrmc_slot() {
+    scheduler_.release(service_);
+  }
+
+  osrmc_slot(const osrmc_slot&) = delete;
+  osrmc_slot& operator=(const osrmc_slot&) = delete;
+
+private:
+  osrmc_scheduler& scheduler_;
+  service_type_t service_;
+};
+
+// Blocks the calling thread until the scheduler grants a slot. Deadlines and cancellation tokens are polled while
+// the request is queued, so a queued request gives up its place as soon as either fires. Without `params` the
+// request is queued for tenant 0 and waits until it is granted.
+static bool
+osrmc_admission_wait(osrmc_scheduler& scheduler, service_type_t service, const void* params, osrmc_error_t* error) {
+  struct grant final {
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool started = false;
+  };
+  const auto state = std::make_shared<grant>();
+  const auto start = [state] {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->started = true;
+    state->ready.notify_one();
+  };
+  uint64_t id = 0;
+  if (!scheduler.admit(service, params ? osrmc_controls_tenant(params) : 0, start, &id)) {
+    osrmc_set_error(error, "Overloaded", "Admission queue is full");
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (!state->ready.wait_for(lock, std::chrono::milliseconds(5), [&state] { return state->started; })) {
+    if (params && !osrmc_check_controls(params, nullptr)) {
+      lock.unlock();
+      if (scheduler.withdraw(service, id)) {
+        osrmc_check_controls(params, error);
+        return false;
+      }
+      // Granted in the meantime
+      lock.lock();
+    }
+  }
+  return true;
+}
+
+// Queues `task` on the pool once the scheduler grants a slot; returns false when the lane queue is full
+template<typename Task>
+static bool
+osrmc_schedule_task(osrmc_osrm_t osrm, service_type_t service, const void* params, Task task) {
+  auto& pool = osrm->pool();
+  auto& scheduler = osrm->scheduler;
+  if (!scheduler.enabled()) {
+    pool.submit(std::move(task));
+    return true;
+  }
+  auto run = [&scheduler, service, task = std::move(task)] {
+    osrmc_slot slot(scheduler, service);
+    osrmc_slot_granted = true;
+    task();
+    osrmc_slot_granted = false;
+  };
+  const auto start = [&pool, run = std::move(run)] {
+    try {
+      pool.submit(run);
+    } catch (...) {
+      // Start functions must not throw; run in place rather than lose the request
+      run();
+    }
+  };
+  uint64_t id = 0;
+  return scheduler.admit(service, osrmc_controls_tenant(params), start, &id);
+}
+
+// Slots of a request that fans out over the pool, released together when the request is done
+class osrmc_slots final {
+public:
+  osrmc_slots(osrmc_scheduler& scheduler, service_type_t service) : scheduler_(scheduler), service_(service) {}
+  ~osrmc_slots() {
+    for (; count_ > 0; --count_) {
+      scheduler_.release(service_);
+    }
+  }
+
+  osrmc_slots(const osrmc_slots&) = delete;
+  osrmc_slots& operator=(const osrmc_slots&) = delete;
+
+  // Takes over a slot granted by osrmc_admission_wait
+  void
+  hold() {
+    ++count_;
+  }
+
+  // Takes up to `extra` more slots that are free right now; returns how many it got
+  size_t
+  widen(size_t extra) {
+    size_t taken = 0;
+    while (taken < extra && scheduler_.try_acquire(service_)) {
+      ++taken;
+    }
+    count_ += taken;
+    return taken;
+  }
+
+private:
+  osrmc_scheduler& scheduler_;
+  service_type_t service_;
+  size_t count_ = 0;
+};
+
+// True when a service call on the calling thread has to wait for admission. Pool workers never wait: everything
+// they run was admitted already, and a worker waiting for a slot can block the very tasks queued behind it that
+// would free one.
+static bool
+osrmc_needs_admission(osrmc_osrm_t osrm, bool granted) {
+  return osrm->scheduler.enabled() && !granted && !osrmc_worker_pool::is_worker_of(osrm);
+}
+
+// Admits a request that runs up to `wanted` items at once on the pool and returns how many it may run at once, or 0
+// with `error` set. The first slot is waited for as for a single request; further ones are only taken while free,
+// so the fan-out shrinks under load. Slots taken are held by `slots` until the request is done.
+static size_t
+osrmc_admit_parallel(osrmc_osrm_t osrm,
+                     service_type_t service,
+                     const void* params,
+                     bool granted,
+                     size_t wanted,
+                     std::optional<osrmc_slots>& slots,
+                     osrmc_error_t* error) {
+  if (!osrm || !osrm->scheduler.enabled()) {
+    return wanted;
+  }
+  slots.emplace(osrm->scheduler, service);
+  if (osrmc_needs_admission(osrm, granted)) {
+    if (!osrmc_admission_wait(osrm->scheduler, service, params, error)) {
+      return 0;
+    }
+    slots->hold();
+  }
+  return 1 + slots->widen(wanted - 1);
+}
+
+template<typename ParamsHandle, typename ResponseHandle, typename ServiceFunc>
+static void
+osrmc_batch_helper(osrmc_osrm_t osrm,
+                   const ParamsHandle* params,
+                   size_t n,
+                   ResponseHandle* out,
+                   osrmc_error_t* errors,
+                   service_type_t service,
+                   ServiceFunc func) {
+  const bool granted = std::exchange(osrmc_slot_granted, false);
+  if (n == 0) {
+    return;
+  }
+  const auto fail = [&](const char* code, const char* message) {
+    for (size_t i = 0; i < n; ++i) {
+      if (out) {
+        out[i] = nullptr;
+      }
+      if (errors) {
+        errors[i] = nullptr;
+        osrmc_set_error(&errors[i], code, message);
+      }
+    }
+  };
+  if (!params || !out) {
+    fail("InvalidArgument", "Params and output arrays must not be null");
+    return;
+  }
+
+  // The batch is admitted once, as a request of its first item, and runs on one thread per slot it holds
+  std::optional<osrmc_slots> slots;
+  size_t width = 0;
+  osrmc_error_t admission_error = nullptr;
+  try {
+    width = osrmc_admit_parallel(osrm, service, params[0], granted, n, slots, &admission_error);
+  } catch (const std::exception& e) {
+    osrmc_error_from_exception(e, &admission_error);
+  }
+  if (width == 0) {
+    fail(osrmc_error_code(admission_error), osrmc_error_message(admission_error));
+    osrmc_error_destruct(admission_error);
+    return;
+  }
+  osrmc_parallel_for(
+    osrmc_pool_or_null(osrm),
+    n,
+    [&](size_t i) {
+      osrmc_error_t* error = errors ? &errors[i] : nullptr;
+      if (error) {
+        *error = nullptr;
+      }
+      // Items run within the slots of the batch
+      osrmc_slot_granted = slots.has_value();
+      out[i] = func(osrm, params[i], error);
+      osrmc_slot_granted = false;
+    },
+    width);
+}
+
+
+// Response allocators
+// Adapts caller allocation callbacks to flatbuffers::Allocator. Without a reallocate callback the base class
+// allocates, copies the used parts and deallocates.
+class osrmc_callback_allocator final : public flatbuffers::Allocator {
+public:
+  explicit osrmc_callback_allocator(const osrmc_allocator_t& callbacks) : callbacks_(callbacks) {}
+
+  uint8_t*
+  allocate(size_t size) override {
+    uint8_t* p = callbacks_.allocate(size, callbacks_.userdata);
+    if (!p) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+  void
+  deallocate(uint8_t* p, size_t size) override {
+    callbacks_.deallocate(p, size, callbacks_.userdata);
+  }
+
+  uint8_t*
+  reallocate_downward(uint8_t* old_p,
+                      size_t old_size,
+                      size_t new_size,
+                      size_t in_use_back,
+                      size_t in_use_front) override {
+    if (!callbacks_.reallocate_downward) {
+      return flatbuffers::Allocator::reallocate_downward(old_p, old_size, new_size, in_use_back, in_use_front);
+    }
+    uint8_t* p = callbacks_.reallocate_downward(
+      old_p, old_size, new_size, in_use_back, in_use_front, callbacks_.userdata);
+    if (!p) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+private:
+  const osrmc_allocator_t callbacks_;
+};
+
+static bool
+osrmc_is_valid_allocator(const osrmc_allocator_t* allocator) {
+  return allocator->allocate && allocator->deallocate;
+}
+
+static void
+osrmc_response_destruct_helper(osrmc_response* response) {
+  osrmc_response_pool::recycle(std::unique_ptr<osrmc_response>(response));
+}
+
+// Response builders grow in caller memory when an allocator is installed on the request or, failing that, on the
+// OSRM instance. The builder owns its adapter, so detached buffers can be freed after the instance is gone.
+// Otherwise the builder comes from the response pool of the calling thread when the instance enables one.
+static std::unique_ptr<osrmc_response>
+osrmc_make_response(const osrmc_osrm& osrm, const void* params) {
+  auto allocator =
+    osrmc_read_controls(params, [](const osrmc_request_controls& controls) { return controls.allocator; });
+  if (!allocator) {
+    allocator = osrm.allocator;
+  }
+  if (!allocator) {
+    auto response = osrm.response_pool.capacity > 0 ? osrmc_response_pool::acquire(osrm.response_pool)
+                                                    : std::make_unique<osrmc_response>();
+    if (!std::holds_alternative<flatbuffers::FlatBufferBuilder>(response->result)) {
+      response->result = flatbuffers::FlatBufferBuilder();
+    }
+    response->pool = osrm.response_pool;
+    return response;
+  }
+  auto adapter = std::make_unique<osrmc_callback_allocator>(*allocator);
+  flatbuffers::FlatBufferBuilder builder(1024, adapter.get(), true);
+  adapter.release();
+  return std::make_unique<osrmc_response>(osrmc_response{std::move(builder), true, {}, {}, 0});
+}
+
+// Runs `call(result)` on the engine behind admission control, or joins an identical request already in flight.
+// Returns nullopt with `error` set when the request gets no result.
+template<typename ParamsType, typename CallFunc>
+static std::optional<osrm::Status>
+osrmc_execute_request(osrmc_osrm_t osrm,
+                      service_type_t service,
+                      const ParamsType& params,
+                      bool granted,
+                      CallFunc call,
+                      osrm::engine::api::ResultT& result,
+                      osrmc_error_t* error) {
+  const void* handle = &params;
+  const auto execute = [&](osrm::engine::api::ResultT& out) -> std::optional<osrm::Status> {
+    std::optional<osrmc_slot> slot;
+    if (osrmc_needs_admission(osrm, granted)) {
+      if (!osrmc_admission_wait(osrm->scheduler, service, handle, error)) {
+        return std::nullopt;
+      }
+      slot.emplace(osrm->scheduler, service);
+    }
+    const auto status = call(out);
+    // A request that failed because its own deadline or token fired, such as a tiled table stopped between blocks,
+    // reports that to its caller only; identical requests waiting on it retry instead of sharing the failure
+    if (status != osrm::Status::Ok && !osrmc_check_controls(handle, error)) {
+      return std::nullopt;
+    }
+    return status;
+  };
+  if (!osrm->flights.enabled()) {
+    return execute(result);
+  }
+  osrmc_request_key key(service);
+  osrmc_add_key_fields(key, params);
+  const auto stop = [handle](osrmc_error_t* stop_error) { return !osrmc_check_controls(handle, stop_error); };
+  return osrm->flights.run(key.str(), execute, stop, result, error);
+}
+
+// Reports the error of a failed engine call
+static void
+osrmc_error_from_result(osrm::engine::api::ResultT& result, const char* error_name, osrmc_error_t* error) {
+  // Extract error from response, fallback to generic error
+  try {
+    if (error) {
+      // Errors are returned as JSON even when format is flatbuffers
+      // Try to extract error from result if it's JSON (for error responses)
+      if (std::holds_alternative<osrm::json::Object>(result)) {
+        auto& json = std::get<osrm::json::Object>(result);
+        auto code = std::get<osrm::json::String>(json.values["code"]).value;
+        auto message = std::get<osrm::json::String>(json.values["message"]).value;
+        if (code.empty()) {
+          code = "Unknown";
+        }
+        osrmc_set_error(error, code.c_str(), message.c_str());
+      } else {
+        osrmc_set_error(error, error_name, "Request failed");
+      }
+    }
+  } catch (...) {
+    osrmc_set_error(error, error_name, "Request failed");
+  }
+}
+
+// Service helpers
+template<typename ParamsHandle, typename ParamsType, typename ResponseHandle, typename MethodFunc>
+static ResponseHandle
+osrmc_service_helper(osrmc_osrm_t osrm,
+                     ParamsHandle params,
+                     service_type_t service,
+                     MethodFunc method,
+                     const char* error_name,
+                     osrmc_error_t* error) try {
+  const bool granted = std::exchange(osrmc_slot_granted, false);
+  if (!osrm) {
+    osrmc_set_error(error, "InvalidArgument", "OSRM instance must not be null");
+    return nullptr;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return nullptr;
+  }
+  // OSRM offers no way to interrupt a running query, so controls are checked when the request starts and again
+  // when it returns; a result that arrives after the deadline or a cancellation is dropped
+  if (!osrmc_check_controls(params, error)) {
+    return nullptr;
+  }
+  auto* osrm_typed = &osrm->engine;
+  auto* params_typed = reinterpret_cast<ParamsType*>(params);
+
+  // Always use FlatBuffer format
+  auto response = osrmc_make_response(*osrm, params);
+  const auto outcome = osrmc_execute_request(
+    osrm,
+    service,
+    *params_typed,
+    granted,
+    [&](osrm::engine::api::ResultT& out) { return method(*osrm_typed, *params_typed, out); },
+    response->result,
+    error);
+  if (!outcome) {
+    return nullptr;
+  }
+  const auto status = *outcome;
+
+  if (!osrmc_check_controls(params, error)) {
+    return nullptr;
+  }
+  if (status == osrm::Status::Ok) {
+    return reinterpret_cast<ResponseHandle>(response.release());
+  }
+
+  osrmc_error_from_result(response->result, error_name, error);
+  return nullptr;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+// Params assignment helpers
+// Per-request vectors hold per-coordinate data and service-specific index lists. Everything else in a params
+// object is a request option.
+template<typename ParamsType>
+static auto
+osrmc_request_vectors() {
+  using osrm::engine::api::BaseParameters;
+  const auto base = std::make_tuple(&BaseParameters::coordinates,
+                                    &BaseParameters::hints,
+                                    &BaseParameters::radiuses,
+                                    &BaseParameters::bearings,
+                                    &BaseParameters::approaches);
+  if constexpr (std::is_same_v<ParamsType, osrm::TableParameters>) {
+    return std::tuple_cat(base, std::make_tuple(&osrm::TableParameters::sources, &osrm::TableParameters::destinations));
+  } else if constexpr (std::is_same_v<ParamsType, osrm::MatchParameters>) {
+    return std::tuple_cat(base,
+                          std::make_tuple(&osrm::MatchParameters::waypoints, &osrm::MatchParameters::timestamps));
+  } else if constexpr (std::is_base_of_v<osrm::RouteParameters, ParamsType>) {
+    return std::tuple_cat(base, std::make_tuple(&osrm::RouteParameters::waypoints));
+  } else {
+    return base;
+  }
+}
+
+// Request options of every params type, i.e. all members but the per-request vectors. Members that OSRM adds to
+// its parameter types have to be listed here or in osrmc_request_vectors.
+template<typename ParamsType>
+static auto
+osrmc_request_options() {
+  using osrm::engine::api::BaseParameters;
+  const auto base = std::make_tuple(&BaseParameters::generate_hints,
+                                    &BaseParameters::exclude,
+                                    &BaseParameters::format,
+                                    &BaseParameters::skip_waypoints,
+                                    &BaseParameters::snapping);
+  const auto route = std::make_tuple(&osrm::RouteParameters::steps,
+                                     &osrm::RouteParameters::alternatives,
+                                     &osrm::RouteParameters::number_of_alternatives,
+                                     &osrm::RouteParameters::annotations,
+                                     &osrm::RouteParameters::annotations_type,
+                                     &osrm::RouteParameters::geometries,
+                                     &osrm::RouteParameters::overview,
+                                     &osrm::RouteParameters::continue_straight);
+  if constexpr (std::is_same_v<ParamsType, osrm::NearestParameters>) {
+    return std::tuple_cat(base, std::make_tuple(&osrm::NearestParameters::number_of_results));
+  } else if constexpr (std::is_same_v<ParamsType, osrm::TableParameters>) {
+    return std::tuple_cat(base,
+                          std::make_tuple(&osrm::TableParameters::fallback_speed,
+                                          &osrm::TableParameters::fallback_coordinate_type,
+                                          &osrm::TableParameters::annotations,
+                                          &osrm::TableParameters::scale_factor));
+  } else if constexpr (std::is_same_v<ParamsType, osrm::MatchParameters>) {
+    return std::tuple_cat(base, route, std::make_tuple(&osrm::MatchParameters::gaps, &osrm::MatchParameters::tidy));
+  } else if constexpr (std::is_same_v<ParamsType, osrm::TripParameters>) {
+    return std::tuple_cat(base,
+                          route,
+                          std::make_tuple(&osrm::TripParameters::source,
+                                          &osrm::TripParameters::destination,
+                                          &osrm::TripParameters::roundtrip));
+  } else {
+    return std::tuple_cat(base, route);
+  }
+}
+
+// Copies the request options of `source` into `params` and clears the `recycled` vectors. The per-request vectors
+// of `source` are never copied, and the cleared vectors keep their allocated capacity, so a reused params object
+// does not reallocate on the next request.
+template<typename ParamsType, typename Members>
+static void
+osrmc_assign_params_helper(ParamsType& params, const ParamsType& source, const Members& recycled) {
+  std::apply([&](auto... member) { ((params.*member).clear(), ...); }, recycled);
+  std::apply([&](auto... member) { ((params.*member = source.*member), ...); }, osrmc_request_options<ParamsType>());
+}
+
+template<typename ParamsType>
+static void
+osrmc_reset_params_helper(ParamsType& params) {
+  using osrm::engine::api::BaseParameters;
+  ParamsType defaults;
+  defaults.format = BaseParameters::OutputFormatType::FLATBUFFERS;
+  osrmc_assign_params_helper(
+    params, defaults, std::tuple_cat(osrmc_request_vectors<ParamsType>(), std::make_tuple(&BaseParameters::exclude)));
+  osrmc_erase_controls(&params);
+}
+
+template<typename ParamsType>
+static void
+osrmc_apply_template_helper(ParamsType& params, const ParamsType& template_params) {
+  if (&params != &template_params) {
+    osrmc_assign_params_helper(params, template_params, osrmc_request_vectors<ParamsType>());
+  }
+}
+
+/* Config */
+
+osrmc_config_t
+osrmc_config_construct(const char* base_path, osrmc_error_t* error) try {
+  auto* out = new osrmc_config;
+
+  if (base_path) {
+    out->engine.storage_config = osrm::StorageConfig(std::filesystem::path(base_path));
+    out->engine.use_shared_memory = false;
+  } else {
+    out->engine.use_shared_memory = true;
+  }
+
+  return out;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_config_destruct(osrmc_config_t config) {
+  if (config) {
+    delete config;
+  }
+}
+
+void
+osrmc_config_set_max_locations_trip(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->max_locations_trip = max_locations;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_max_locations_trip(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
+  if (!out_max_locations) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_max_locations = config_typed->max_locations_trip;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_max_locations_viaroute(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->max_locations_viaroute = max_locations;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_max_locations_viaroute(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
+  if (!out_max_locations) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_max_locations = config_typed->max_locations_viaroute;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_max_locations_distance_table(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->max_locations_distance_table = max_locations;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_max_locations_distance_table(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
+  if (!out_max_locations) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_max_locations = config_typed->max_locations_distance_table;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_max_locations_map_matching(osrmc_config_t config, int max_locations, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->max_locations_map_matching = max_locations;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_max_locations_map_matching(osrmc_config_t config, int* out_max_locations, osrmc_error_t* error) try {
+  if (!out_max_locations) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_max_locations = config_typed->max_locations_map_matching;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_max_radius_map_matching(osrmc_config_t config, double max_radius, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->max_radius_map_matching = max_radius;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_max_radius_map_matching(osrmc_config_t config, double* out_max_radius, osrmc_error_t* error) try {
+  if (!out_max_radius) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_max_radius = config_typed->max_radius_map_matching;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_max_results_nearest(osrmc_config_t config, int max_results, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->max_results_nearest = max_results;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
 osrmc_config_get_max_results_nearest(osrmc_config_t config, int* out_max_results, osrmc_error_t* error) try {
   if (!out_max_results) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_max_results = config_typed->max_results_nearest;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_default_radius(osrmc_config_t config, double default_radius, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->default_radius = default_radius;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_default_radius(osrmc_config_t config, double* out_default_radius, osrmc_error_t* error) try {
+  if (!out_default_radius) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_default_radius = config_typed->default_radius;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_max_alternatives(osrmc_config_t config, int max_alternatives, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->max_alternatives = max_alternatives;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_max_alternatives(osrmc_config_t config, int* out_max_alternatives, osrmc_error_t* error) try {
+  if (!out_max_alternatives) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_max_alternatives = config_typed->max_alternatives;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_use_shared_memory(osrmc_config_t config, bool use_shared_memory, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->use_shared_memory = use_shared_memory;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_use_shared_memory(osrmc_config_t config, bool* out_use_shared_memory, osrmc_error_t* error) try {
+  if (!out_use_shared_memory) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_use_shared_memory = config_typed->use_shared_memory;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_memory_file(osrmc_config_t config, const char* memory_file, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  if (memory_file) {
+    config_typed->memory_file = std::filesystem::path(memory_file);
+  } else {
+    config_typed->memory_file.clear();
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_memory_file(osrmc_config_t config, const char** out_memory_file, osrmc_error_t* error) try {
+  if (!out_memory_file) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  // On Windows, path::c_str() returns wchar_t*, so we need to convert to string first
+  thread_local static std::string memory_file_str;
+  memory_file_str = config_typed->memory_file.string();
+  *out_memory_file = memory_file_str.c_str();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_use_mmap(osrmc_config_t config, bool use_mmap, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->use_mmap = use_mmap;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_use_mmap(osrmc_config_t config, bool* out_use_mmap, osrmc_error_t* error) try {
+  if (!out_use_mmap) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_use_mmap = config_typed->use_mmap;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_algorithm(osrmc_config_t config, algorithm_t algorithm, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+
+  switch (algorithm) {
+    case ALGORITHM_CH:
+      config_typed->algorithm = osrm::EngineConfig::Algorithm::CH;
+      break;
+    case ALGORITHM_MLD:
+      config_typed->algorithm = osrm::EngineConfig::Algorithm::MLD;
+      break;
+    default:
+      osrmc_set_error(error, "InvalidAlgorithm", "Unknown algorithm type");
+      return;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_algorithm(osrmc_config_t config, algorithm_t* out_algorithm, osrmc_error_t* error) try {
+  if (!out_algorithm) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  switch (config_typed->algorithm) {
+    case osrm::EngineConfig::Algorithm::CH:
+      *out_algorithm = ALGORITHM_CH;
+      break;
+    case osrm::EngineConfig::Algorithm::MLD:
+      *out_algorithm = ALGORITHM_MLD;
+      break;
+    default:
+      osrmc_set_error(error, "InvalidAlgorithm", "Unknown algorithm type in config");
+      return;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+static const char*
+osrmc_feature_dataset_name(osrm::storage::FeatureDataset dataset) {
+  switch (dataset) {
+    case osrm::storage::FeatureDataset::ROUTE_STEPS:
+      return "route_steps";
+    case osrm::storage::FeatureDataset::ROUTE_GEOMETRY:
+      return "route_geometry";
+  }
+  return "";
+}
+
+void
+osrmc_config_disable_feature_dataset(osrmc_config_t config, const char* dataset_name, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!dataset_name) {
+    osrmc_set_error(error, "InvalidDataset", "Dataset name must not be null");
+    return;
+  }
+
+  auto* config_typed = &config->engine;
+  // Convert to lowercase and check dataset name
+  std::string lower_name = dataset_name;
+  std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(), [](unsigned char ch) {
+    return static_cast<char>(std::tolower(ch));
+  });
+  std::optional<osrm::storage::FeatureDataset> dataset;
+  if (lower_name == "route_steps") {
+    dataset = osrm::storage::FeatureDataset::ROUTE_STEPS;
+  } else if (lower_name == "route_geometry") {
+    dataset = osrm::storage::FeatureDataset::ROUTE_GEOMETRY;
+  }
+  if (!dataset) {
+    osrmc_set_error(error, "InvalidDataset", "Unknown dataset");
+    return;
+  }
+
+  const auto exists =
+    std::find(config_typed->disable_feature_dataset.begin(), config_typed->disable_feature_dataset.end(), *dataset) !=
+    config_typed->disable_feature_dataset.end();
+  if (!exists) {
+    config_typed->disable_feature_dataset.push_back(*dataset);
+    const auto base_path = config_typed->storage_config.base_path;
+    if (!base_path.empty()) {
+      config_typed->storage_config = osrm::StorageConfig(base_path, config_typed->disable_feature_dataset);
+    } else {
+      config_typed->storage_config = osrm::StorageConfig(config_typed->disable_feature_dataset);
+    }
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_disabled_feature_dataset_count(osrmc_config_t config, size_t* out_count, osrmc_error_t* error) try {
+  if (!out_count) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_count = config_typed->disable_feature_dataset.size();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_disabled_feature_dataset_at(osrmc_config_t config,
+                                             size_t index,
+                                             const char** out_dataset_name,
+                                             osrmc_error_t* error) try {
+  if (!out_dataset_name) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  if (index >= config_typed->disable_feature_dataset.size()) {
+    osrmc_set_error(error, "InvalidIndex", "Dataset index out of range");
+    return;
+  }
+  *out_dataset_name = osrmc_feature_dataset_name(config_typed->disable_feature_dataset[index]);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_verbosity(osrmc_config_t config, const char* verbosity, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->verbosity = verbosity ? verbosity : "";
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_verbosity(osrmc_config_t config, const char** out_verbosity, osrmc_error_t* error) try {
+  if (!out_verbosity) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_verbosity = config_typed->verbosity.c_str();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_dataset_name(osrmc_config_t config, const char* dataset_name, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->dataset_name = dataset_name ? dataset_name : "";
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_dataset_name(osrmc_config_t config, const char** out_dataset_name, osrmc_error_t* error) try {
+  if (!out_dataset_name) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  *out_dataset_name = config_typed->dataset_name.c_str();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_clear_disabled_feature_datasets(osrmc_config_t config, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  auto* config_typed = &config->engine;
+  config_typed->disable_feature_dataset.clear();
+  const auto base_path = config_typed->storage_config.base_path;
+  if (!base_path.empty()) {
+    config_typed->storage_config = osrm::StorageConfig(base_path, config_typed->disable_feature_dataset);
+  } else {
+    config_typed->storage_config = osrm::StorageConfig(config_typed->disable_feature_dataset);
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_worker_threads(osrmc_config_t config, int threads, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (threads < 0) {
+    osrmc_set_error(error, "InvalidArgument", "Worker thread count must not be negative");
+    return;
+  }
+  config->workers.threads = static_cast<unsigned>(threads);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_worker_threads(osrmc_config_t config, int* out_threads, osrmc_error_t* error) try {
+  if (!out_threads) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_threads = static_cast<int>(config->workers.threads);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_worker_cpus(osrmc_config_t config, const int* cpus, size_t count, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (count > 0 && !cpus) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  if (std::any_of(cpus, cpus + count, [](int cpu) { return cpu < 0; })) {
+    osrmc_set_error(error, "InvalidArgument", "CPU indices must not be negative");
+    return;
+  }
+  config->workers.cpus.assign(cpus, cpus + count);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_worker_cpu_count(osrmc_config_t config, size_t* out_count, osrmc_error_t* error) try {
+  if (!out_count) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_count = config->workers.cpus.size();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_worker_cpu(osrmc_config_t config, size_t index, int* out_cpu, osrmc_error_t* error) try {
+  if (!out_cpu) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (index >= config->workers.cpus.size()) {
+    osrmc_set_error(error, "InvalidIndex", "CPU index out of range");
+    return;
+  }
+  *out_cpu = config->workers.cpus[index];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_worker_stack_size(osrmc_config_t config, size_t stack_size, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  config->workers.stack_size = stack_size;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_worker_stack_size(osrmc_config_t config, size_t* out_stack_size, osrmc_error_t* error) try {
+  if (!out_stack_size) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_stack_size = config->workers.stack_size;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+// Enum values arrive from C callers unchecked
+static bool
+osrmc_is_valid_lane(lane_t lane) {
+  return lane == LANE_INTERACTIVE || lane == LANE_BULK;
+}
+
+static bool
+osrmc_is_valid_service(service_type_t service) {
+  return static_cast<size_t>(service) < osrmc_service_count;
+}
+
+void
+osrmc_config_set_max_active_requests(osrmc_config_t config, unsigned max_active, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  config->admission.max_active = max_active;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_max_active_requests(osrmc_config_t config, unsigned* out_max_active, osrmc_error_t* error) try {
+  if (!out_max_active) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_max_active = config->admission.max_active;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_lane_limit(osrmc_config_t config, lane_t lane, unsigned max_active, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_lane(lane)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown lane");
+    return;
+  }
+  config->admission.lane_limits[lane] = max_active;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_lane_limit(osrmc_config_t config, lane_t lane, unsigned* out_max_active, osrmc_error_t* error) try {
+  if (!out_max_active) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_lane(lane)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown lane");
+    return;
+  }
+  *out_max_active = config->admission.lane_limits[lane];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_lane_queue_capacity(osrmc_config_t config, lane_t lane, size_t capacity, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_lane(lane)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown lane");
+    return;
+  }
+  config->admission.queue_capacities[lane] = capacity;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_lane_queue_capacity(osrmc_config_t config,
+                                     lane_t lane,
+                                     size_t* out_capacity,
+                                     osrmc_error_t* error) try {
+  if (!out_capacity) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_lane(lane)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown lane");
+    return;
+  }
+  *out_capacity = config->admission.queue_capacities[lane];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_service_limit(osrmc_config_t config,
+                               service_type_t service,
+                               unsigned max_active,
+                               osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_service(service)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown service");
+    return;
+  }
+  config->admission.service_limits[service] = max_active;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_service_limit(osrmc_config_t config,
+                               service_type_t service,
+                               unsigned* out_max_active,
+                               osrmc_error_t* error) try {
+  if (!out_max_active) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_service(service)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown service");
+    return;
+  }
+  *out_max_active = config->admission.service_limits[service];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_service_lane(osrmc_config_t config, service_type_t service, lane_t lane, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_service(service)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown service");
+    return;
+  }
+  if (!osrmc_is_valid_lane(lane)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown lane");
+    return;
+  }
+  config->admission.service_lanes[service] = lane;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_service_lane(osrmc_config_t config,
+                              service_type_t service,
+                              lane_t* out_lane,
+                              osrmc_error_t* error) try {
+  if (!out_lane) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (!osrmc_is_valid_service(service)) {
+    osrmc_set_error(error, "InvalidArgument", "Unknown service");
+    return;
+  }
+  *out_lane = config->admission.service_lanes[service];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_tenant_weight(osrmc_config_t config, uint32_t tenant, unsigned weight, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (weight == 0) {
+    osrmc_set_error(error, "InvalidArgument", "Tenant weight must be positive");
+    return;
+  }
+  config->admission.tenant_weights[tenant] = weight;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_tenant_weight(osrmc_config_t config, uint32_t tenant, unsigned* out_weight, osrmc_error_t* error) try {
+  if (!out_weight) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  const auto found = config->admission.tenant_weights.find(tenant);
+  *out_weight = found == config->admission.tenant_weights.end() ? 1 : found->second;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_coalesce_requests(osrmc_config_t config, bool coalesce_requests, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  config->coalesce_requests = coalesce_requests;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_coalesce_requests(osrmc_config_t config, bool* out_coalesce_requests, osrmc_error_t* error) try {
+  if (!out_coalesce_requests) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_coalesce_requests = config->coalesce_requests;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_allow_large_tiled_tables(osrmc_config_t config, bool allow, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  config->allow_large_tiled_tables = allow;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_allow_large_tiled_tables(osrmc_config_t config, bool* out_allow, osrmc_error_t* error) try {
+  if (!out_allow) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_allow = config->allow_large_tiled_tables;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_allocator(osrmc_config_t config, const osrmc_allocator_t* allocator, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  if (allocator && !osrmc_is_valid_allocator(allocator)) {
+    osrmc_set_error(error, "InvalidArgument", "Allocator must provide allocate and deallocate");
+    return;
+  }
+  config->allocator = allocator ? std::optional<osrmc_allocator_t>(*allocator) : std::nullopt;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_allocator(osrmc_config_t config, osrmc_allocator_t* out_allocator, osrmc_error_t* error) try {
+  if (!out_allocator) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_allocator = config->allocator.value_or(osrmc_allocator_t{});
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_set_response_pool(osrmc_config_t config,
+                               size_t capacity,
+                               size_t max_buffer_size,
+                               osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  config->response_pool = {capacity, max_buffer_size};
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_config_get_response_pool(osrmc_config_t config,
+                               size_t* out_capacity,
+                               size_t* out_max_buffer_size,
+                               osrmc_error_t* error) try {
+  if (!out_capacity || !out_max_buffer_size) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return;
+  }
+  *out_capacity = config->response_pool.capacity;
+  *out_max_buffer_size = config->response_pool.max_buffer_size;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+/* OSRM */
+
+osrmc_osrm_t
+osrmc_osrm_construct(osrmc_config_t config, osrmc_error_t* error) try {
+  if (!config) {
+    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+    return nullptr;
+  }
+  return new osrmc_osrm(*config);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_osrm_destruct(osrmc_osrm_t osrm) {
+  if (!osrm) {
+    return;
+  }
+  // A worker cannot join itself, so from a worker the instance is destroyed on a separate thread once the
+  // calling task has returned
+  if (osrmc_worker_pool::is_worker_of(osrm)) {
+    try {
+      std::thread([osrm] { delete osrm; }).detach();
+      return;
+    } catch (const std::exception&) {
+      // No thread to hand over to; leak the instance rather than deadlock
+      return;
+    }
+  }
+  delete osrm;
+}
+
+/* Request control */
+
+int64_t
+osrmc_now_ms(void) {
+  return osrmc_steady_now_ms();
+}
+
+osrmc_cancel_token_t
+osrmc_cancel_token_construct(osrmc_error_t* error) try {
+  return reinterpret_cast<osrmc_cancel_token_t>(new osrmc_cancel_token);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_cancel_token_destruct(osrmc_cancel_token_t token) {
+  osrmc_cancel_token_release(reinterpret_cast<osrmc_cancel_token*>(token));
+}
+
+void
+osrmc_cancel_token_cancel(osrmc_cancel_token_t token, osrmc_error_t* error) {
+  if (!token) {
+    osrmc_set_error(error, "InvalidArgument", "Token must not be null");
+    return;
+  }
+  reinterpret_cast<osrmc_cancel_token*>(token)->cancelled.store(true, std::memory_order_release);
+}
+
+void
+osrmc_cancel_token_is_cancelled(osrmc_cancel_token_t token, int* out_cancelled, osrmc_error_t* error) {
+  if (!out_cancelled) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!token) {
+    osrmc_set_error(error, "InvalidArgument", "Token must not be null");
+    return;
+  }
+  *out_cancelled = reinterpret_cast<osrmc_cancel_token*>(token)->cancelled.load(std::memory_order_acquire) ? 1 : 0;
+}
+
+void
+osrmc_params_set_deadline(osrmc_params_t params, int64_t deadline_ms, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  osrmc_update_controls(params, [&](osrmc_request_controls& controls) {
+    controls.deadline_ms = deadline_ms > 0 ? deadline_ms : 0;
+  });
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_deadline(osrmc_params_t params, int64_t* out_deadline_ms, osrmc_error_t* error) try {
+  if (!out_deadline_ms) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  *out_deadline_ms =
+    osrmc_read_controls(params, [](const osrmc_request_controls& controls) { return controls.deadline_ms; });
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_timeout(osrmc_params_t params, unsigned timeout_ms, osrmc_error_t* error) {
+  osrmc_params_set_deadline(params, osrmc_steady_now_ms() + static_cast<int64_t>(timeout_ms), error);
+}
+
+void
+osrmc_params_set_cancel_token(osrmc_params_t params, osrmc_cancel_token_t token, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* token_typed = reinterpret_cast<osrmc_cancel_token*>(token);
+  osrmc_cancel_token* previous = nullptr;
+  osrmc_update_controls(params, [&](osrmc_request_controls& controls) {
+    previous = controls.token;
+    controls.token = token_typed;
+    if (token_typed) {
+      token_typed->references.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  osrmc_cancel_token_release(previous);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_tenant(osrmc_params_t params, uint32_t tenant, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  osrmc_update_controls(params, [tenant](osrmc_request_controls& controls) { controls.tenant = tenant; });
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_tenant(osrmc_params_t params, uint32_t* out_tenant, osrmc_error_t* error) try {
+  if (!out_tenant) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  *out_tenant = osrmc_controls_tenant(params);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_allocator(osrmc_params_t params, const osrmc_allocator_t* allocator, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (allocator && !osrmc_is_valid_allocator(allocator)) {
+    osrmc_set_error(error, "InvalidArgument", "Allocator must provide allocate and deallocate");
+    return;
+  }
+  osrmc_update_controls(params, [allocator](osrmc_request_controls& controls) {
+    controls.allocator = allocator ? std::optional<osrmc_allocator_t>(*allocator) : std::nullopt;
+  });
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_allocator(osrmc_params_t params, osrmc_allocator_t* out_allocator, osrmc_error_t* error) try {
+  if (!out_allocator) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  *out_allocator = osrmc_read_controls(params, [](const osrmc_request_controls& controls) {
+    return controls.allocator.value_or(osrmc_allocator_t{});
+  });
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+/* Base */
+
+// Values outside approach_t mean "unset"
+static std::optional<osrm::engine::Approach>
+osrmc_to_approach(int approach) {
+  switch (approach) {
+    case APPROACH_CURB:
+      return osrm::engine::Approach::CURB;
+    case APPROACH_UNRESTRICTED:
+      return osrm::engine::Approach::UNRESTRICTED;
+    case APPROACH_OPPOSITE:
+      return osrm::engine::Approach::OPPOSITE;
+    default:
+      return std::nullopt;
+  }
+}
+
+static bool
+osrmc_check_coordinate_count(const osrm::engine::api::BaseParameters& params,
+                             size_t count,
+                             const char* name,
+                             osrmc_error_t* error) {
+  if (count != params.coordinates.size()) {
+    const std::string message = std::string(name) + " count must match coordinate count";
+    osrmc_set_error(error, "InvalidArgument", message.c_str());
+    return false;
+  }
+  return true;
+}
+
+void
+osrmc_params_add_coordinate(osrmc_params_t params, double longitude, double latitude, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+
+  params_typed->coordinates.emplace_back(osrm::util::FloatLongitude{longitude}, osrm::util::FloatLatitude{latitude});
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_coordinate_count(osrmc_params_t params, size_t* out_count, osrmc_error_t* error) try {
+  if (!out_count) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  *out_count = params_typed->coordinates.size();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_coordinate(osrmc_params_t params,
+                            size_t coordinate_index,
+                            double* out_longitude,
+                            double* out_latitude,
+                            osrmc_error_t* error) try {
+  if (!out_longitude || !out_latitude) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+    return;
+  }
+  *out_longitude = static_cast<double>(static_cast<std::int32_t>(params_typed->coordinates[coordinate_index].lon)) /
+                   osrm::COORDINATE_PRECISION;
+  *out_latitude = static_cast<double>(static_cast<std::int32_t>(params_typed->coordinates[coordinate_index].lat)) /
+                  osrm::COORDINATE_PRECISION;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_add_coordinate_with(osrmc_params_t params,
+                                 double longitude,
+                                 double latitude,
+                                 double radius,
+                                 int bearing,
+                                 int range,
+                                 osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+
+  params_typed->coordinates.emplace_back(osrm::util::FloatLongitude{longitude}, osrm::util::FloatLatitude{latitude});
+  params_typed->radiuses.emplace_back(radius);
+  params_typed->bearings.emplace_back(osrm::Bearing{static_cast<short>(bearing), static_cast<short>(range)});
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_add_coordinates(osrmc_params_t params,
+                             const double* longitudes,
+                             const double* latitudes,
+                             size_t count,
+                             osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && (!longitudes || !latitudes)) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointers must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+
+  osrmc_append_coordinates(
+    *params_typed,
+    count,
+    [&](size_t first, size_t chunk, std::int32_t* out) {
+      return osrmc_coordinates_to_fixed(longitudes + first, latitudes + first, chunk, out);
+    },
+    error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_add_coordinates_interleaved(osrmc_params_t params,
+                                         const double* lonlat,
+                                         size_t count,
+                                         osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !lonlat) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+
+  osrmc_append_coordinates(
+    *params_typed,
+    count,
+    [&](size_t first, size_t chunk, std::int32_t* out) {
+      return osrmc_coordinates_interleaved_to_fixed(lonlat + 2 * first, chunk, out);
+    },
+    error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_add_coordinates_fixed(osrmc_params_t params,
+                                   const int32_t* longitudes,
+                                   const int32_t* latitudes,
+                                   size_t count,
+                                   osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && (!longitudes || !latitudes)) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointers must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+
+  osrmc_append_coordinates(
+    *params_typed,
+    count,
+    [&](size_t first, size_t chunk, std::int32_t* out) {
+      return osrmc_coordinates_check_fixed(longitudes + first, latitudes + first, chunk, out);
+    },
+    error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_coordinates(osrmc_params_t params,
+                             size_t first,
+                             size_t count,
+                             double* out_longitudes,
+                             double* out_latitudes,
+                             osrmc_error_t* error) try {
+  if (count > 0 && (!out_longitudes || !out_latitudes)) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  const auto& coordinates = params_typed->coordinates;
+  if (first > coordinates.size() || count > coordinates.size() - first) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate range out of bounds");
+    return;
+  }
+  osrmc_coordinates_from_fixed(coordinates.data() + first, count, out_longitudes, out_latitudes);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_coordinates_fixed(osrmc_params_t params,
+                                   size_t first,
+                                   size_t count,
+                                   int32_t* out_longitudes,
+                                   int32_t* out_latitudes,
+                                   osrmc_error_t* error) try {
+  if (count > 0 && (!out_longitudes || !out_latitudes)) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  const auto& coordinates = params_typed->coordinates;
+  if (first > coordinates.size() || count > coordinates.size() - first) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate range out of bounds");
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    out_longitudes[i] = static_cast<std::int32_t>(coordinates[first + i].lon);
+    out_latitudes[i] = static_cast<std::int32_t>(coordinates[first + i].lat);
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_hint(osrmc_params_t params,
+                      size_t coordinate_index,
+                      const char* hint_base64,
+                      osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    const std::string message = std::string("Hint") + " index out of bounds";
+    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
+    return;
+  }
+
+  if (params_typed->hints.size() < params_typed->coordinates.size()) {
+    params_typed->hints.resize(params_typed->coordinates.size());
+  }
+  if (hint_base64) {
+    auto hint = osrm::engine::Hint::FromBase64(hint_base64);
+    params_typed->hints[coordinate_index] = std::move(hint);
+  } else {
+    params_typed->hints[coordinate_index] = std::nullopt;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_hint(osrmc_params_t params,
+                      size_t coordinate_index,
+                      const char** out_hint_base64,
+                      osrmc_error_t* error) try {
+  if (!out_hint_base64) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+    return;
+  }
+  if (coordinate_index >= params_typed->hints.size() || !params_typed->hints[coordinate_index]) {
+    *out_hint_base64 = nullptr;
+    return;
+  }
+  // Use thread_local storage to hold the converted base64 string
+  thread_local static std::string hint_base64_storage;
+  hint_base64_storage = params_typed->hints[coordinate_index]->ToBase64();
+  *out_hint_base64 = hint_base64_storage.c_str();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+size_t
+osrmc_hint_segment_size(void) {
+  return sizeof(osrm::engine::SegmentHint);
+}
+
+void
+osrmc_params_set_hint_binary(osrmc_params_t params,
+                             size_t coordinate_index,
+                             const uint8_t* data,
+                             size_t size,
+                             osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Hint index out of bounds");
+    return;
+  }
+  if (data && !osrmc_is_valid_hint_size(size)) {
+    osrmc_set_error(error, "InvalidArgument", "Hint size must be a non-zero multiple of the segment hint size");
+    return;
+  }
+
+  if (params_typed->hints.size() < params_typed->coordinates.size()) {
+    params_typed->hints.resize(params_typed->coordinates.size());
+  }
+  if (data) {
+    params_typed->hints[coordinate_index] = osrmc_hint_from_binary(data, size);
+  } else {
+    params_typed->hints[coordinate_index] = std::nullopt;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_hint_binary(osrmc_params_t params,
+                             size_t coordinate_index,
+                             uint8_t* out_data,
+                             size_t capacity,
+                             size_t* out_size,
+                             osrmc_error_t* error) try {
+  if (!out_size) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+    return;
+  }
+  if (coordinate_index >= params_typed->hints.size() || !params_typed->hints[coordinate_index]) {
+    *out_size = 0;
+    return;
+  }
+  const auto& segment_hints = params_typed->hints[coordinate_index]->segment_hints;
+  *out_size = segment_hints.size() * sizeof(osrm::engine::SegmentHint);
+  if (!out_data) {
+    return;
+  }
+  if (*out_size > capacity) {
+    osrmc_set_error(error, "InvalidArgument", "Output buffer too small");
+    return;
+  }
+  std::memcpy(out_data, segment_hints.data(), *out_size);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_radius(osrmc_params_t params, size_t coordinate_index, double radius, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    const std::string message = std::string("Radius") + " index out of bounds";
+    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
+    return;
+  }
+
+  if (params_typed->radiuses.size() < params_typed->coordinates.size()) {
+    params_typed->radiuses.resize(params_typed->coordinates.size());
+  }
+  if (radius >= 0.0) {
+    params_typed->radiuses[coordinate_index] = radius;
+  } else {
+    params_typed->radiuses[coordinate_index] = std::nullopt;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_radius(osrmc_params_t params,
+                        size_t coordinate_index,
+                        double* out_radius,
+                        int* out_is_set,
+                        osrmc_error_t* error) try {
+  if (!out_radius || !out_is_set) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+    return;
+  }
+  if (coordinate_index >= params_typed->radiuses.size() || !params_typed->radiuses[coordinate_index]) {
+    *out_is_set = 0;
+    return;
+  }
+  *out_is_set = 1;
+  *out_radius = *params_typed->radiuses[coordinate_index];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_bearing(osrmc_params_t params,
+                         size_t coordinate_index,
+                         int value,
+                         int range,
+                         osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    const std::string message = std::string("Bearing") + " index out of bounds";
+    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
+    return;
+  }
+
+  if (params_typed->bearings.size() < params_typed->coordinates.size()) {
+    params_typed->bearings.resize(params_typed->coordinates.size());
+  }
+  if (value < 0 || range < 0) {
+    params_typed->bearings[coordinate_index] = std::nullopt;
+    return;
+  }
+
+  params_typed->bearings[coordinate_index] = osrm::Bearing{static_cast<short>(value), static_cast<short>(range)};
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_bearing(osrmc_params_t params,
+                         size_t coordinate_index,
+                         int* out_value,
+                         int* out_range,
+                         int* out_is_set,
+                         osrmc_error_t* error) try {
+  if (!out_value || !out_range || !out_is_set) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+    return;
+  }
+  if (coordinate_index >= params_typed->bearings.size() || !params_typed->bearings[coordinate_index]) {
+    *out_is_set = 0;
+    return;
+  }
+  *out_is_set = 1;
+  *out_value = params_typed->bearings[coordinate_index]->bearing;
+  *out_range = params_typed->bearings[coordinate_index]->range;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_approach(osrmc_params_t params,
+                          size_t coordinate_index,
+                          approach_t approach,
+                          osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    const std::string message = std::string("Approach") + " index out of bounds";
+    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
+    return;
+  }
+
+  if (params_typed->approaches.size() < params_typed->coordinates.size()) {
+    params_typed->approaches.resize(params_typed->coordinates.size());
+  }
+  params_typed->approaches[coordinate_index] = osrmc_to_approach(approach);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_approach(osrmc_params_t params,
+                          size_t coordinate_index,
+                          approach_t* out_approach,
+                          int* out_is_set,
+                          osrmc_error_t* error) try {
+  if (!out_approach || !out_is_set) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (coordinate_index >= params_typed->coordinates.size()) {
+    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+    return;
+  }
+  if (coordinate_index >= params_typed->approaches.size() || !params_typed->approaches[coordinate_index]) {
+    *out_is_set = 0;
+    return;
+  }
+  *out_is_set = 1;
+  switch (*params_typed->approaches[coordinate_index]) {
+    case osrm::engine::Approach::CURB:
+      *out_approach = APPROACH_CURB;
+      break;
+    case osrm::engine::Approach::UNRESTRICTED:
+      *out_approach = APPROACH_UNRESTRICTED;
+      break;
+    case osrm::engine::Approach::OPPOSITE:
+      *out_approach = APPROACH_OPPOSITE;
+      break;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_hints(osrmc_params_t params, const char* const* hints_base64, size_t count, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !hints_base64) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (!osrmc_check_coordinate_count(*params_typed, count, "Hint", error)) {
+    return;
+  }
+
+  // Decode into a fresh vector so a malformed hint leaves the params untouched
+  std::vector<std::optional<osrm::engine::Hint>> hints;
+  hints.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (hints_base64[i]) {
+      hints.emplace_back(osrm::engine::Hint::FromBase64(hints_base64[i]));
+    } else {
+      hints.emplace_back(std::nullopt);
+    }
+  }
+  params_typed->hints = std::move(hints);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_hints_binary(osrmc_params_t params,
+                              const uint8_t* data,
+                              const size_t* sizes,
+                              size_t count,
+                              osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !sizes) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (!osrmc_check_coordinate_count(*params_typed, count, "Hint", error)) {
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (sizes[i] > 0 && (!data || !osrmc_is_valid_hint_size(sizes[i]))) {
+      osrmc_set_error(error, "InvalidArgument", "Hint size must be a non-zero multiple of the segment hint size");
+      return;
+    }
+  }
+
+  std::vector<std::optional<osrm::engine::Hint>> hints;
+  hints.reserve(count);
+  size_t offset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (sizes[i] > 0) {
+      hints.emplace_back(osrmc_hint_from_binary(data + offset, sizes[i]));
+      offset += sizes[i];
+    } else {
+      hints.emplace_back(std::nullopt);
+    }
+  }
+  params_typed->hints = std::move(hints);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_radiuses(osrmc_params_t params, const double* radiuses, size_t count, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !radiuses) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (!osrmc_check_coordinate_count(*params_typed, count, "Radius", error)) {
+    return;
+  }
+
+  auto& radiuses_typed = params_typed->radiuses;
+  radiuses_typed.clear();
+  radiuses_typed.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (radiuses[i] >= 0.0) {
+      radiuses_typed.emplace_back(radiuses[i]);
+    } else {
+      radiuses_typed.emplace_back(std::nullopt);
+    }
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_bearings(osrmc_params_t params,
+                          const int* values,
+                          const int* ranges,
+                          size_t count,
+                          osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && (!values || !ranges)) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointers must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (!osrmc_check_coordinate_count(*params_typed, count, "Bearing", error)) {
+    return;
+  }
+
+  auto& bearings = params_typed->bearings;
+  bearings.clear();
+  bearings.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (values[i] < 0 || ranges[i] < 0) {
+      bearings.emplace_back(std::nullopt);
+    } else {
+      bearings.emplace_back(osrm::Bearing{static_cast<short>(values[i]), static_cast<short>(ranges[i])});
+    }
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_approaches(osrmc_params_t params,
+                            const approach_t* approaches,
+                            size_t count,
+                            osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !approaches) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (!osrmc_check_coordinate_count(*params_typed, count, "Approach", error)) {
+    return;
+  }
+
+  auto& approaches_typed = params_typed->approaches;
+  approaches_typed.clear();
+  approaches_typed.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    approaches_typed.emplace_back(osrmc_to_approach(approaches[i]));
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_add_exclude(osrmc_params_t params, const char* exclude_profile, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (!exclude_profile) {
+    osrmc_set_error(error, "InvalidExclude", "Exclude profile must not be null");
+    return;
+  }
+
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  params_typed->exclude.emplace_back(exclude_profile);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_exclude_count(osrmc_params_t params, size_t* out_count, osrmc_error_t* error) try {
+  if (!out_count) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  *out_count = params_typed->exclude.size();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_exclude(osrmc_params_t params,
+                         size_t index,
+                         const char** out_exclude_profile,
+                         osrmc_error_t* error) try {
+  if (!out_exclude_profile) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  if (index >= params_typed->exclude.size()) {
+    osrmc_set_error(error, "InvalidIndex", "Exclude index out of bounds");
+    return;
+  }
+  *out_exclude_profile = params_typed->exclude[index].c_str();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_generate_hints(osrmc_params_t params, int on, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  params_typed->generate_hints = on != 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_generate_hints(osrmc_params_t params, int* out_on, osrmc_error_t* error) try {
+  if (!out_on) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  *out_on = params_typed->generate_hints ? 1 : 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_skip_waypoints(osrmc_params_t params, int on, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  params_typed->skip_waypoints = on != 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_skip_waypoints(osrmc_params_t params, int* out_on, osrmc_error_t* error) try {
+  if (!out_on) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  *out_on = params_typed->skip_waypoints ? 1 : 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_set_snapping(osrmc_params_t params, snapping_t snapping, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  switch (snapping) {
+    case SNAPPING_DEFAULT:
+      params_typed->snapping = osrm::engine::api::BaseParameters::SnappingType::Default;
+      break;
+    case SNAPPING_ANY:
+      params_typed->snapping = osrm::engine::api::BaseParameters::SnappingType::Any;
+      break;
+    default:
+      osrmc_set_error(error, "InvalidSnapping", "Unknown snapping type");
+      return;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_params_get_snapping(osrmc_params_t params, snapping_t* out_snapping, osrmc_error_t* error) try {
+  if (!out_snapping) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
+  switch (params_typed->snapping) {
+    case osrm::engine::api::BaseParameters::SnappingType::Default:
+      *out_snapping = SNAPPING_DEFAULT;
+      break;
+    case osrm::engine::api::BaseParameters::SnappingType::Any:
+      *out_snapping = SNAPPING_ANY;
+      break;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+
+/* Nearest */
+
+osrmc_nearest_params_t
+osrmc_nearest_params_construct(osrmc_error_t* error) try {
+  auto* out = osrmc_new_params<osrm::NearestParameters>();
+  // Always set FlatBuffer format
+  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
+  return reinterpret_cast<osrmc_nearest_params_t>(out);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_nearest_params_destruct(osrmc_nearest_params_t params) {
+  if (params) {
+    osrmc_delete_params(reinterpret_cast<osrm::NearestParameters*>(params));
+  }
+}
+
+void
+osrmc_nearest_params_reset(osrmc_nearest_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::NearestParameters*>(params);
+  osrmc_reset_params_helper(*params_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+osrmc_nearest_params_t
+osrmc_nearest_params_clone(osrmc_nearest_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return nullptr;
+  }
+  auto* params_typed = reinterpret_cast<osrm::NearestParameters*>(params);
+  auto* out = osrmc_new_params<osrm::NearestParameters>(*params_typed);
+  return reinterpret_cast<osrmc_nearest_params_t>(out);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_nearest_params_apply_template(osrmc_nearest_params_t params,
+                                    osrmc_nearest_params_t template_params,
+                                    osrmc_error_t* error) try {
+  if (!params || !template_params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::NearestParameters*>(params);
+  auto* template_typed = reinterpret_cast<osrm::NearestParameters*>(template_params);
+  osrmc_apply_template_helper(*params_typed, *template_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_nearest_params_set_number_of_results(osrmc_nearest_params_t params, unsigned n, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::NearestParameters*>(params);
+  params_typed->number_of_results = n;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_nearest_params_get_number_of_results(osrmc_nearest_params_t params, unsigned* out_n, osrmc_error_t* error) try {
+  if (!out_n) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::NearestParameters*>(params);
+  *out_n = params_typed->number_of_results;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+osrmc_nearest_response_t
+osrmc_nearest(osrmc_osrm_t osrm, osrmc_nearest_params_t params, osrmc_error_t* error) {
+  return osrmc_service_helper<osrmc_nearest_params_t, osrm::NearestParameters, osrmc_nearest_response_t>(
+    osrm,
+    params,
+    SERVICE_NEAREST,
+    [](osrm::OSRM& o, osrm::NearestParameters& p, osrm::engine::api::ResultT& r) { return o.Nearest(p, r); },
+    "NearestError",
+    error);
+}
+
+void
+osrmc_nearest_response_destruct(osrmc_nearest_response_t response) {
+  if (response) {
+    osrmc_response_destruct_helper(reinterpret_cast<osrmc_response*>(response));
+  }
+}
+
+void
+osrmc_nearest_batch(osrmc_osrm_t osrm,
+                    const osrmc_nearest_params_t* params,
+                    size_t n,
+                    osrmc_nearest_response_t* out,
+                    osrmc_error_t* errors) {
+  osrmc_batch_helper(osrm, params, n, out, errors, SERVICE_NEAREST, osrmc_nearest);
+}
+
+void
+osrmc_nearest_response_transfer_flatbuffer(osrmc_nearest_response_t response,
+                                           uint8_t** data,
+                                           size_t* size,
+                                           void (**deleter)(void*),
+                                           osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    if (data)
+      *data = nullptr;
+    if (size)
+      *size = 0;
+    if (deleter)
+      *deleter = nullptr;
+    return;
+  }
+  if (!data || !size || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  if (data)
+    *data = nullptr;
+  if (size)
+    *size = 0;
+  if (deleter)
+    *deleter = nullptr;
+}
+
+void
+osrmc_nearest_response_detach_flatbuffer(osrmc_nearest_response_t response,
+                                         uint8_t** data,
+                                         size_t* size,
+                                         void** owner,
+                                         void (**deleter)(void*),
+                                         osrmc_error_t* error) try {
+  if (!data || !size || !owner || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    *data = nullptr;
+    *size = 0;
+    *owner = nullptr;
+    *deleter = nullptr;
+    return;
+  }
+  osrmc_detach_flatbuffer_helper(reinterpret_cast<osrmc_response*>(response), data, size, owner, deleter, error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_nearest_response_get_hint_count(osrmc_nearest_response_t response,
+                                      size_t* out_count,
+                                      size_t* out_size,
+                                      osrmc_error_t* error) try {
+  if (!out_count || !out_size) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    return;
+  }
+  osrmc_response_get_hint_count_helper(reinterpret_cast<osrmc_response*>(response), out_count, out_size, error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_nearest_response_get_hints(osrmc_nearest_response_t response,
+                                 uint8_t* out_data,
+                                 size_t capacity,
+                                 size_t* out_sizes,
+                                 size_t count,
+                                 osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    return;
+  }
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_response_get_hints_helper(resp, out_data, capacity, out_sizes, count, error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+/* Route */
+
+osrmc_route_params_t
+osrmc_route_params_construct(osrmc_error_t* error) try {
+  auto* out = osrmc_new_params<osrm::RouteParameters>();
+  // Always set FlatBuffer format
+  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
+  return reinterpret_cast<osrmc_route_params_t>(out);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_route_params_destruct(osrmc_route_params_t params) {
+  if (params) {
+    osrmc_delete_params(reinterpret_cast<osrm::RouteParameters*>(params));
+  }
+}
+
+void
+osrmc_route_params_reset(osrmc_route_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  osrmc_reset_params_helper(*params_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+osrmc_route_params_t
+osrmc_route_params_clone(osrmc_route_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return nullptr;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* out = osrmc_new_params<osrm::RouteParameters>(*params_typed);
+  return reinterpret_cast<osrmc_route_params_t>(out);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_route_params_apply_template(osrmc_route_params_t params,
+                                  osrmc_route_params_t template_params,
+                                  osrmc_error_t* error) try {
+  if (!params || !template_params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* template_typed = reinterpret_cast<osrm::RouteParameters*>(template_params);
+  osrmc_apply_template_helper(*params_typed, *template_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_set_steps(osrmc_route_params_t params, int on, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  params_typed->steps = on != 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_get_steps(osrmc_route_params_t params, int* out_on, osrmc_error_t* error) try {
+  if (!out_on) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  *out_on = params_typed->steps ? 1 : 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_set_alternatives(osrmc_route_params_t params, int on, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  params_typed->alternatives = on != 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_get_alternatives(osrmc_route_params_t params, int* out_on, osrmc_error_t* error) try {
+  if (!out_on) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  *out_on = params_typed->alternatives ? 1 : 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_set_geometries(osrmc_route_params_t params, geometries_type_t geometries, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  switch (geometries) {
+    case GEOMETRIES_POLYLINE:
+      params_typed->geometries = osrm::RouteParameters::GeometriesType::Polyline;
+      break;
+    case GEOMETRIES_POLYLINE6:
+      params_typed->geometries = osrm::RouteParameters::GeometriesType::Polyline6;
+      break;
+    case GEOMETRIES_GEOJSON:
+      params_typed->geometries = osrm::RouteParameters::GeometriesType::GeoJSON;
+      break;
+    default:
+      osrmc_set_error(error, "InvalidArgument", "Unknown geometries type");
+      return;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_get_geometries(osrmc_route_params_t params,
+                                  geometries_type_t* out_geometries,
+                                  osrmc_error_t* error) try {
+  if (!out_geometries) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  switch (params_typed->geometries) {
+    case osrm::RouteParameters::GeometriesType::Polyline:
+      *out_geometries = GEOMETRIES_POLYLINE;
+      break;
+    case osrm::RouteParameters::GeometriesType::Polyline6:
+      *out_geometries = GEOMETRIES_POLYLINE6;
+      break;
+    case osrm::RouteParameters::GeometriesType::GeoJSON:
+      *out_geometries = GEOMETRIES_GEOJSON;
+      break;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_set_overview(osrmc_route_params_t params, overview_type_t overview, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  switch (overview) {
+    case OVERVIEW_SIMPLIFIED:
+      params_typed->overview = osrm::RouteParameters::OverviewType::Simplified;
+      break;
+    case OVERVIEW_FULL:
+      params_typed->overview = osrm::RouteParameters::OverviewType::Full;
+      break;
+    case OVERVIEW_FALSE:
+      params_typed->overview = osrm::RouteParameters::OverviewType::False;
+      break;
+    default:
+      osrmc_set_error(error, "InvalidArgument", "Unknown overview type");
+      return;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_get_overview(osrmc_route_params_t params, overview_type_t* out_overview, osrmc_error_t* error) try {
+  if (!out_overview) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  switch (params_typed->overview) {
+    case osrm::RouteParameters::OverviewType::Simplified:
+      *out_overview = OVERVIEW_SIMPLIFIED;
+      break;
+    case osrm::RouteParameters::OverviewType::Full:
+      *out_overview = OVERVIEW_FULL;
+      break;
+    case osrm::RouteParameters::OverviewType::False:
+      *out_overview = OVERVIEW_FALSE;
+      break;
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_set_continue_straight(osrmc_route_params_t params, int on, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  if (on < 0) {
+    params_typed->continue_straight = std::nullopt;
+  } else {
+    params_typed->continue_straight = (on != 0);
+  }
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_get_continue_straight(osrmc_route_params_t params,
+                                         int* out_on,
+                                         int* out_is_set,
+                                         osrmc_error_t* error) try {
+  if (!out_on || !out_is_set) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  if (!params_typed->continue_straight) {
+    *out_is_set = 0;
+    return;
+  }
+  *out_is_set = 1;
+  *out_on = *params_typed->continue_straight ? 1 : 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_set_number_of_alternatives(osrmc_route_params_t params, unsigned count, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  params_typed->number_of_alternatives = count;
+  params_typed->alternatives = count > 0;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_get_number_of_alternatives(osrmc_route_params_t params,
+                                              unsigned* out_count,
+                                              osrmc_error_t* error) try {
+  if (!out_count) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_max_results = config_typed->max_results_nearest;
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  *out_count = params_typed->number_of_alternatives;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_set_default_radius(osrmc_config_t config, double default_radius, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_route_params_set_annotations(osrmc_route_params_t params,
+                                   annotations_type_t annotations,
+                                   osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->default_radius = default_radius;
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  params_typed->annotations_type = static_cast<osrm::RouteParameters::AnnotationsType>(annotations);
+  params_typed->annotations = (annotations != ANNOTATIONS_NONE);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_default_radius(osrmc_config_t config, double* out_default_radius, osrmc_error_t* error) try {
-  if (!out_default_radius) {
+osrmc_route_params_get_annotations(osrmc_route_params_t params,
+                                   annotations_type_t* out_annotations,
+                                   osrmc_error_t* error) try {
+  if (!out_annotations) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_default_radius = config_typed->default_radius;
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  *out_annotations = static_cast<annotations_type_t>(params_typed->annotations_type);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_set_max_alternatives(osrmc_config_t config, int max_alternatives, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_route_params_add_waypoint(osrmc_route_params_t params, size_t index, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->max_alternatives = max_alternatives;
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  params_typed->waypoints.emplace_back(index);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_max_alternatives(osrmc_config_t config, int* out_max_alternatives, osrmc_error_t* error) try {
-  if (!out_max_alternatives) {
+osrmc_route_params_get_waypoint_count(osrmc_route_params_t params, size_t* out_count, osrmc_error_t* error) try {
+  if (!out_count) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_max_alternatives = config_typed->max_alternatives;
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  *out_count = params_typed->waypoints.size();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_set_use_shared_memory(osrmc_config_t config, bool use_shared_memory, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_route_params_get_waypoint(osrmc_route_params_t params,
+                                size_t index,
+                                size_t* out_index,
+                                osrmc_error_t* error) try {
+  if (!out_index) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->use_shared_memory = use_shared_memory;
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  if (index >= params_typed->waypoints.size()) {
+    osrmc_set_error(error, "InvalidIndex", "Waypoint index out of bounds");
+    return;
+  }
+  *out_index = params_typed->waypoints[index];
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_use_shared_memory(osrmc_config_t config, bool* out_use_shared_memory, osrmc_error_t* error) try {
-  if (!out_use_shared_memory) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+osrmc_route_params_clear_waypoints(osrmc_route_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  params_typed->waypoints.clear();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_route_params_set_waypoints(osrmc_route_params_t params,
+                                 const size_t* indices,
+                                 size_t count,
+                                 osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_use_shared_memory = config_typed->use_shared_memory;
+  if (count > 0 && !indices) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  params_typed->waypoints.assign(indices, indices + count);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
+osrmc_route_response_t
+osrmc_route(osrmc_osrm_t osrm, osrmc_route_params_t params, osrmc_error_t* error) {
+  return osrmc_service_helper<osrmc_route_params_t, osrm::RouteParameters, osrmc_route_response_t>(
+    osrm,
+    params,
+    SERVICE_ROUTE,
+    [](osrm::OSRM& o, osrm::RouteParameters& p, osrm::engine::api::ResultT& r) { return o.Route(p, r); },
+    "RouteError",
+    error);
+}
+
 void
-osrmc_config_set_memory_file(osrmc_config_t config, const char* memory_file, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_route_response_destruct(osrmc_route_response_t response) {
+  if (response) {
+    osrmc_response_destruct_helper(reinterpret_cast<osrmc_response*>(response));
+  }
+}
+
+void
+osrmc_route_batch(osrmc_osrm_t osrm,
+                  const osrmc_route_params_t* params,
+                  size_t n,
+                  osrmc_route_response_t* out,
+                  osrmc_error_t* errors) {
+  osrmc_batch_helper(osrm, params, n, out, errors, SERVICE_ROUTE, osrmc_route);
+}
+
+void
+osrmc_route_response_transfer_flatbuffer(osrmc_route_response_t response,
+                                         uint8_t** data,
+                                         size_t* size,
+                                         void (**deleter)(void*),
+                                         osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    if (data)
+      *data = nullptr;
+    if (size)
+      *size = 0;
+    if (deleter)
+      *deleter = nullptr;
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  if (memory_file) {
-    config_typed->memory_file = std::filesystem::path(memory_file);
-  } else {
-    config_typed->memory_file.clear();
+  if (!data || !size || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
   }
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  if (data)
+    *data = nullptr;
+  if (size)
+    *size = 0;
+  if (deleter)
+    *deleter = nullptr;
 }
 
 void
-osrmc_config_get_memory_file(osrmc_config_t config, const char** out_memory_file, osrmc_error_t* error) try {
-  if (!out_memory_file) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+osrmc_route_response_detach_flatbuffer(osrmc_route_response_t response,
+                                       uint8_t** data,
+                                       size_t* size,
+                                       void** owner,
+                                       void (**deleter)(void*),
+                                       osrmc_error_t* error) try {
+  if (!data || !size || !owner || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    *data = nullptr;
+    *size = 0;
+    *owner = nullptr;
+    *deleter = nullptr;
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  // On Windows, path::c_str() returns wchar_t*, so we need to convert to string first
-  thread_local static std::string memory_file_str;
-  memory_file_str = config_typed->memory_file.string();
-  *out_memory_file = memory_file_str.c_str();
+  osrmc_detach_flatbuffer_helper(reinterpret_cast<osrmc_response*>(response), data, size, owner, deleter, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_set_use_mmap(osrmc_config_t config, bool use_mmap, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_route_response_get_hint_count(osrmc_route_response_t response,
+                                    size_t* out_count,
+                                    size_t* out_size,
+                                    osrmc_error_t* error) try {
+  if (!out_count || !out_size) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->use_mmap = use_mmap;
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    return;
+  }
+  osrmc_response_get_hint_count_helper(reinterpret_cast<osrmc_response*>(response), out_count, out_size, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_use_mmap(osrmc_config_t config, bool* out_use_mmap, osrmc_error_t* error) try {
-  if (!out_use_mmap) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+osrmc_route_response_get_hints(osrmc_route_response_t response,
+                               uint8_t* out_data,
+                               size_t capacity,
+                               size_t* out_sizes,
+                               size_t count,
+                               osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_response_get_hints_helper(resp, out_data, capacity, out_sizes, count, error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+/* Table */
+
+osrmc_table_params_t
+osrmc_table_params_construct(osrmc_error_t* error) try {
+  auto* out = osrmc_new_params<osrm::TableParameters>();
+  // Always set FlatBuffer format
+  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
+  return reinterpret_cast<osrmc_table_params_t>(out);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
+}
+
+void
+osrmc_table_params_destruct(osrmc_table_params_t params) {
+  if (params) {
+    osrmc_delete_params(reinterpret_cast<osrm::TableParameters*>(params));
+  }
+}
+
+void
+osrmc_table_params_reset(osrmc_table_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_use_mmap = config_typed->use_mmap;
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  osrmc_reset_params_helper(*params_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+osrmc_table_params_t
+osrmc_table_params_clone(osrmc_table_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return nullptr;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  auto* out = osrmc_new_params<osrm::TableParameters>(*params_typed);
+  return reinterpret_cast<osrmc_table_params_t>(out);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
 void
-osrmc_config_set_algorithm(osrmc_config_t config, algorithm_t algorithm, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_table_params_apply_template(osrmc_table_params_t params,
+                                  osrmc_table_params_t template_params,
+                                  osrmc_error_t* error) try {
+  if (!params || !template_params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  auto* template_typed = reinterpret_cast<osrm::TableParameters*>(template_params);
+  osrmc_apply_template_helper(*params_typed, *template_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
 
-  switch (algorithm) {
-    case ALGORITHM_CH:
-      config_typed->algorithm = osrm::EngineConfig::Algorithm::CH;
-      break;
-    case ALGORITHM_MLD:
-      config_typed->algorithm = osrm::EngineConfig::Algorithm::MLD;
-      break;
-    default:
-      osrmc_set_error(error, "InvalidAlgorithm", "Unknown algorithm type");
-      return;
+void
+osrmc_table_params_add_source(osrmc_table_params_t params, size_t index, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
   }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->sources.emplace_back(index);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_algorithm(osrmc_config_t config, algorithm_t* out_algorithm, osrmc_error_t* error) try {
-  if (!out_algorithm) {
+osrmc_table_params_get_source_count(osrmc_table_params_t params, size_t* out_count, osrmc_error_t* error) try {
+  if (!out_count) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  switch (config_typed->algorithm) {
-    case osrm::EngineConfig::Algorithm::CH:
-      *out_algorithm = ALGORITHM_CH;
-      break;
-    case osrm::EngineConfig::Algorithm::MLD:
-      *out_algorithm = ALGORITHM_MLD;
-      break;
-    default:
-      osrmc_set_error(error, "InvalidAlgorithm", "Unknown algorithm type in config");
-      return;
-  }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  *out_count = params_typed->sources.size();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-static const char*
-osrmc_feature_dataset_name(osrm::storage::FeatureDataset dataset) {
-  switch (dataset) {
-    case osrm::storage::FeatureDataset::ROUTE_STEPS:
-      return "route_steps";
-    case osrm::storage::FeatureDataset::ROUTE_GEOMETRY:
-      return "route_geometry";
+void
+osrmc_table_params_get_source(osrmc_table_params_t params, size_t index, size_t* out_index, osrmc_error_t* error) try {
+  if (!out_index) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
   }
-  return "";
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  if (index >= params_typed->sources.size()) {
+    osrmc_set_error(error, "InvalidIndex", "Source index out of bounds");
+    return;
+  }
+  *out_index = params_typed->sources[index];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_disable_feature_dataset(osrmc_config_t config, const char* dataset_name, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_table_params_set_sources(osrmc_table_params_t params,
+                               const size_t* indices,
+                               size_t count,
+                               osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  if (!dataset_name) {
-    osrmc_set_error(error, "InvalidDataset", "Dataset name must not be null");
+  if (count > 0 && !indices) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
     return;
   }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->sources.assign(indices, indices + count);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
 
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  // Convert to lowercase and check dataset name
-  std::string lower_name = dataset_name;
-  std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(), [](unsigned char ch) {
-    return static_cast<char>(std::tolower(ch));
-  });
-  std::optional<osrm::storage::FeatureDataset> dataset;
-  if (lower_name == "route_steps") {
-    dataset = osrm::storage::FeatureDataset::ROUTE_STEPS;
-  } else if (lower_name == "route_geometry") {
-    dataset = osrm::storage::FeatureDataset::ROUTE_GEOMETRY;
+void
+osrmc_table_params_set_source_range(osrmc_table_params_t params, size_t first, size_t count, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
   }
-  if (!dataset) {
-    osrmc_set_error(error, "InvalidDataset", "Unknown dataset");
+  if (count > SIZE_MAX - first) {
+    osrmc_set_error(error, "InvalidArgument", "Source range overflows");
     return;
   }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->sources.resize(count);
+  std::iota(params_typed->sources.begin(), params_typed->sources.end(), first);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
 
-  const auto exists =
-    std::find(config_typed->disable_feature_dataset.begin(), config_typed->disable_feature_dataset.end(), *dataset) !=
-    config_typed->disable_feature_dataset.end();
-  if (!exists) {
-    config_typed->disable_feature_dataset.push_back(*dataset);
-    const auto base_path = config_typed->storage_config.base_path;
-    if (!base_path.empty()) {
-      config_typed->storage_config = osrm::StorageConfig(base_path, config_typed->disable_feature_dataset);
-    } else {
-      config_typed->storage_config = osrm::StorageConfig(config_typed->disable_feature_dataset);
-    }
+void
+osrmc_table_params_add_destination(osrmc_table_params_t params, size_t index, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
   }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->destinations.emplace_back(index);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_disabled_feature_dataset_count(osrmc_config_t config, size_t* out_count, osrmc_error_t* error) try {
+osrmc_table_params_get_destination_count(osrmc_table_params_t params, size_t* out_count, osrmc_error_t* error) try {
   if (!out_count) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_count = config_typed->disable_feature_dataset.size();
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  *out_count = params_typed->destinations.size();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_disabled_feature_dataset_at(osrmc_config_t config,
-                                             size_t index,
-                                             const char** out_dataset_name,
-                                             osrmc_error_t* error) try {
-  if (!out_dataset_name) {
+osrmc_table_params_get_destination(osrmc_table_params_t params,
+                                   size_t index,
+                                   size_t* out_index,
+                                   osrmc_error_t* error) try {
+  if (!out_index) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  if (index >= config_typed->disable_feature_dataset.size()) {
-    osrmc_set_error(error, "InvalidIndex", "Dataset index out of range");
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  if (index >= params_typed->destinations.size()) {
+    osrmc_set_error(error, "InvalidIndex", "Destination index out of bounds");
     return;
   }
-  *out_dataset_name = osrmc_feature_dataset_name(config_typed->disable_feature_dataset[index]);
+  *out_index = params_typed->destinations[index];
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_set_verbosity(osrmc_config_t config, const char* verbosity, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_table_params_set_destinations(osrmc_table_params_t params,
+                                    const size_t* indices,
+                                    size_t count,
+                                    osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->verbosity = verbosity ? verbosity : "";
+  if (count > 0 && !indices) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->destinations.assign(indices, indices + count);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_verbosity(osrmc_config_t config, const char** out_verbosity, osrmc_error_t* error) try {
-  if (!out_verbosity) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+osrmc_table_params_set_destination_range(osrmc_table_params_t params,
+                                         size_t first,
+                                         size_t count,
+                                         osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (count > SIZE_MAX - first) {
+    osrmc_set_error(error, "InvalidArgument", "Destination range overflows");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_verbosity = config_typed->verbosity.c_str();
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->destinations.resize(count);
+  std::iota(params_typed->destinations.begin(), params_typed->destinations.end(), first);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_set_dataset_name(osrmc_config_t config, const char* dataset_name, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_table_params_set_annotations(osrmc_table_params_t params,
+                                   table_annotations_type_t annotations,
+                                   osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->dataset_name = dataset_name ? dataset_name : "";
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  switch (annotations) {
+    case TABLE_ANNOTATIONS_NONE:
+      params_typed->annotations = osrm::TableParameters::AnnotationsType::None;
+      break;
+    case TABLE_ANNOTATIONS_DURATION:
+      params_typed->annotations = osrm::TableParameters::AnnotationsType::Duration;
+      break;
+    case TABLE_ANNOTATIONS_DISTANCE:
+      params_typed->annotations = osrm::TableParameters::AnnotationsType::Distance;
+      break;
+    case TABLE_ANNOTATIONS_ALL:
+      params_typed->annotations = osrm::TableParameters::AnnotationsType::All;
+      break;
+    default:
+      osrmc_set_error(error, "InvalidArgument", "Unknown annotations type");
+      return;
+  }
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_get_dataset_name(osrmc_config_t config, const char** out_dataset_name, osrmc_error_t* error) try {
-  if (!out_dataset_name) {
+osrmc_table_params_get_annotations(osrmc_table_params_t params,
+                                   table_annotations_type_t* out_annotations,
+                                   osrmc_error_t* error) try {
+  if (!out_annotations) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  *out_dataset_name = config_typed->dataset_name.c_str();
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  switch (params_typed->annotations) {
+    case osrm::TableParameters::AnnotationsType::None:
+      *out_annotations = TABLE_ANNOTATIONS_NONE;
+      break;
+    case osrm::TableParameters::AnnotationsType::Duration:
+      *out_annotations = TABLE_ANNOTATIONS_DURATION;
+      break;
+    case osrm::TableParameters::AnnotationsType::Distance:
+      *out_annotations = TABLE_ANNOTATIONS_DISTANCE;
+      break;
+    case osrm::TableParameters::AnnotationsType::All:
+      *out_annotations = TABLE_ANNOTATIONS_ALL;
+      break;
+  }
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_config_clear_disabled_feature_datasets(osrmc_config_t config, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
+osrmc_table_params_set_fallback_speed(osrmc_table_params_t params, double speed, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  config_typed->disable_feature_dataset.clear();
-  const auto base_path = config_typed->storage_config.base_path;
-  if (!base_path.empty()) {
-    config_typed->storage_config = osrm::StorageConfig(base_path, config_typed->disable_feature_dataset);
-  } else {
-    config_typed->storage_config = osrm::StorageConfig(config_typed->disable_feature_dataset);
+  if (speed <= 0) {
+    osrmc_set_error(error, "InvalidArgument", "Fallback speed must be positive");
+    return;
   }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->fallback_speed = speed;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-/* OSRM */
-
-osrmc_osrm_t
-osrmc_osrm_construct(osrmc_config_t config, osrmc_error_t* error) try {
-  if (!config) {
-    osrmc_set_error(error, "InvalidArgument", "Config must not be null");
-    return nullptr;
+void
+osrmc_table_params_get_fallback_speed(osrmc_table_params_t params, double* out_speed, osrmc_error_t* error) try {
+  if (!out_speed) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
   }
-  auto* config_typed = reinterpret_cast<osrm::EngineConfig*>(config);
-  auto* out = new osrm::OSRM(*config_typed);
-
-  return reinterpret_cast<osrmc_osrm_t>(out);
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  *out_speed = params_typed->fallback_speed;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  return nullptr;
-}
-
-void
-osrmc_osrm_destruct(osrmc_osrm_t osrm) {
-  if (osrm) {
-    delete reinterpret_cast<osrm::OSRM*>(osrm);
-  }
 }
 
-/* Base */
-
 void
-osrmc_params_add_coordinate(osrmc_params_t params, double longitude, double latitude, osrmc_error_t* error) try {
+osrmc_table_params_set_fallback_coordinate_type(osrmc_table_params_t params,
+                                                table_coordinate_type_t coord_type,
+                                                osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-
-  params_typed->coordinates.emplace_back(osrm::util::FloatLongitude{longitude}, osrm::util::FloatLatitude{latitude});
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  switch (coord_type) {
+    case TABLE_COORDINATE_INPUT:
+      params_typed->fallback_coordinate_type = osrm::TableParameters::FallbackCoordinateType::Input;
+      break;
+    case TABLE_COORDINATE_SNAPPED:
+      params_typed->fallback_coordinate_type = osrm::TableParameters::FallbackCoordinateType::Snapped;
+      break;
+    default:
+      osrmc_set_error(error, "InvalidArgument", "Unknown table coordinate type");
+      return;
+  }
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_get_coordinate_count(osrmc_params_t params, size_t* out_count, osrmc_error_t* error) try {
-  if (!out_count) {
+osrmc_table_params_get_fallback_coordinate_type(osrmc_table_params_t params,
+                                                table_coordinate_type_t* out_coord_type,
+                                                osrmc_error_t* error) try {
+  if (!out_coord_type) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -821,95 +5350,71 @@ osrmc_params_get_coordinate_count(osrmc_params_t params, size_t* out_count, osrm
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  *out_count = params_typed->coordinates.size();
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  switch (params_typed->fallback_coordinate_type) {
+    case osrm::TableParameters::FallbackCoordinateType::Input:
+      *out_coord_type = TABLE_COORDINATE_INPUT;
+      break;
+    case osrm::TableParameters::FallbackCoordinateType::Snapped:
+      *out_coord_type = TABLE_COORDINATE_SNAPPED;
+      break;
+  }
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_get_coordinate(osrmc_params_t params,
-                            size_t coordinate_index,
-                            double* out_longitude,
-                            double* out_latitude,
-                            osrmc_error_t* error) try {
-  if (!out_longitude || !out_latitude) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
-    return;
-  }
+osrmc_table_params_set_scale_factor(osrmc_table_params_t params, double scale_factor, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+  if (scale_factor <= 0) {
+    osrmc_set_error(error, "InvalidArgument", "Scale factor must be positive");
     return;
   }
-  *out_longitude = static_cast<double>(static_cast<std::int32_t>(params_typed->coordinates[coordinate_index].lon)) /
-                   osrm::COORDINATE_PRECISION;
-  *out_latitude = static_cast<double>(static_cast<std::int32_t>(params_typed->coordinates[coordinate_index].lat)) /
-                  osrm::COORDINATE_PRECISION;
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  params_typed->scale_factor = scale_factor;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_add_coordinate_with(osrmc_params_t params,
-                                 double longitude,
-                                 double latitude,
-                                 double radius,
-                                 int bearing,
-                                 int range,
-                                 osrmc_error_t* error) try {
+osrmc_table_params_get_scale_factor(osrmc_table_params_t params, double* out_scale_factor, osrmc_error_t* error) try {
+  if (!out_scale_factor) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-
-  params_typed->coordinates.emplace_back(osrm::util::FloatLongitude{longitude}, osrm::util::FloatLatitude{latitude});
-  params_typed->radiuses.emplace_back(radius);
-  params_typed->bearings.emplace_back(osrm::Bearing{static_cast<short>(bearing), static_cast<short>(range)});
+  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
+  *out_scale_factor = params_typed->scale_factor;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_set_hint(osrmc_params_t params,
-                      size_t coordinate_index,
-                      const char* hint_base64,
-                      osrmc_error_t* error) try {
+osrmc_table_params_set_tile_size(osrmc_table_params_t params, size_t rows, size_t cols, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    const std::string message = std::string("Hint") + " index out of bounds";
-    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
-    return;
-  }
-
-  if (params_typed->hints.size() < params_typed->coordinates.size()) {
-    params_typed->hints.resize(params_typed->coordinates.size());
-  }
-  if (hint_base64) {
-    auto hint = osrm::engine::Hint::FromBase64(hint_base64);
-    params_typed->hints[coordinate_index] = std::move(hint);
-  } else {
-    params_typed->hints[coordinate_index] = std::nullopt;
-  }
+  osrmc_update_controls(params, [rows, cols](osrmc_request_controls& controls) {
+    controls.tile_rows = rows;
+    controls.tile_cols = cols;
+  });
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_get_hint(osrmc_params_t params,
-                      size_t coordinate_index,
-                      const char** out_hint_base64,
-                      osrmc_error_t* error) try {
-  if (!out_hint_base64) {
+osrmc_table_params_get_tile_size(osrmc_table_params_t params,
+                                 size_t* out_rows,
+                                 size_t* out_cols,
+                                 osrmc_error_t* error) try {
+  if (!out_rows || !out_cols) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -917,506 +5422,963 @@ osrmc_params_get_hint(osrmc_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
-    return;
-  }
-  if (coordinate_index >= params_typed->hints.size() || !params_typed->hints[coordinate_index]) {
-    *out_hint_base64 = nullptr;
-    return;
-  }
-  // Use thread_local storage to hold the converted base64 string
-  thread_local static std::string hint_base64_storage;
-  hint_base64_storage = params_typed->hints[coordinate_index]->ToBase64();
-  *out_hint_base64 = hint_base64_storage.c_str();
+  std::tie(*out_rows, *out_cols) = osrmc_read_controls(params, [](const osrmc_request_controls& controls) {
+    return std::make_pair(controls.tile_rows, controls.tile_cols);
+  });
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_params_set_radius(osrmc_params_t params, size_t coordinate_index, double radius, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
-  }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    const std::string message = std::string("Radius") + " index out of bounds";
-    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
-    return;
+// Bytes a matrix cell takes in a table response, 4 per requested annotation
+static size_t
+osrmc_table_cell_size(const osrm::TableParameters& params) {
+  const auto all = static_cast<unsigned>(osrm::TableParameters::AnnotationsType::All);
+  return sizeof(float) * std::max(1, std::popcount(static_cast<unsigned>(params.annotations) & all));
+}
+
+static osrm::json::Object
+osrmc_table_failure(const char* code, const std::string& message) {
+  osrm::json::Object failure;
+  failure.values["code"] = osrm::json::String{code};
+  failure.values["message"] = osrm::json::String{message};
+  return failure;
+}
+
+// Tiled table execution
+// A large matrix is split into blocks of at most tile_rows x tile_cols that run as independent table requests on
+// the worker pool. Each block request only carries its own sources followed by its own destinations, so block
+// requests stay small, and the block matrices are stitched into one response with the layout of a single call.
+struct osrmc_table_block final {
+  size_t row_begin;
+  size_t row_end;
+  size_t col_begin;
+  size_t col_end;
+  osrm::Status status = osrm::Status::Error;
+  osrm::engine::api::ResultT result = flatbuffers::FlatBufferBuilder();
+};
+
+static osrm::TableParameters
+osrmc_table_block_params(const osrm::TableParameters& params,
+                         const std::vector<size_t>& sources,
+                         const std::vector<size_t>& destinations,
+                         const osrmc_table_block& block) {
+  using osrm::engine::api::BaseParameters;
+  osrm::TableParameters out;
+  out.exclude = params.exclude;
+  out.format = params.format;
+  out.generate_hints = params.generate_hints;
+  out.skip_waypoints = params.skip_waypoints;
+  out.snapping = params.snapping;
+  out.fallback_speed = params.fallback_speed;
+  out.fallback_coordinate_type = params.fallback_coordinate_type;
+  out.annotations = params.annotations;
+  out.scale_factor = params.scale_factor;
+
+  std::vector<size_t> picked(sources.begin() + block.row_begin, sources.begin() + block.row_end);
+  picked.insert(picked.end(), destinations.begin() + block.col_begin, destinations.begin() + block.col_end);
+  const auto pick = [&](auto member) {
+    const auto& all = params.*member;
+    if (!all.empty()) {
+      auto& subset = out.*member;
+      subset.reserve(picked.size());
+      for (const size_t index : picked) {
+        subset.push_back(all[index]);
+      }
+    }
+  };
+  pick(&BaseParameters::coordinates);
+  pick(&BaseParameters::hints);
+  pick(&BaseParameters::radiuses);
+  pick(&BaseParameters::bearings);
+  pick(&BaseParameters::approaches);
+
+  const size_t rows = block.row_end - block.row_begin;
+  out.sources.resize(rows);
+  std::iota(out.sources.begin(), out.sources.end(), size_t{0});
+  out.destinations.resize(block.col_end - block.col_begin);
+  std::iota(out.destinations.begin(), out.destinations.end(), rows);
+  return out;
+}
+
+static const osrm::engine::api::fbresult::FBResult*
+osrmc_table_block_result(const osrmc_table_block& block) {
+  const auto& builder = std::get<flatbuffers::FlatBufferBuilder>(block.result);
+  return osrm::engine::api::fbresult::GetFBResult(builder.GetBufferPointer());
+}
+
+// Copies the waypoints of `list` into `builder`; nested strings are created before each waypoint table is started
+static flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>>>
+osrmc_copy_waypoints(
+  flatbuffers::FlatBufferBuilder& builder,
+  const std::vector<const flatbuffers::Vector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>>*>& lists) {
+  namespace fbresult = osrm::engine::api::fbresult;
+  std::vector<flatbuffers::Offset<fbresult::Waypoint>> waypoints;
+  for (const auto* list : lists) {
+    for (const auto* source : *list) {
+      const auto hint = builder.CreateString(source->hint());
+      const auto name = builder.CreateString(source->name());
+      fbresult::WaypointBuilder waypoint(builder);
+      if (source->hint()) {
+        waypoint.add_hint(hint);
+      }
+      if (source->name()) {
+        waypoint.add_name(name);
+      }
+      waypoint.add_distance(source->distance());
+      if (source->location()) {
+        waypoint.add_location(source->location());
+      }
+      if (source->nodes()) {
+        waypoint.add_nodes(source->nodes());
+      }
+      waypoints.push_back(waypoint.Finish());
+    }
   }
+  return builder.CreateVector(waypoints);
+}
 
-  if (params_typed->radiuses.size() < params_typed->coordinates.size()) {
-    params_typed->radiuses.resize(params_typed->coordinates.size());
+// Writes the `annotation` matrix of every block into a rows x cols vector of `builder`; returns a null offset when
+// the blocks carry no such annotation
+template<typename AnnotationFunc>
+static flatbuffers::Offset<flatbuffers::Vector<float>>
+osrmc_stitch_matrix(flatbuffers::FlatBufferBuilder& builder,
+                    const std::vector<osrmc_table_block>& blocks,
+                    size_t rows,
+                    size_t cols,
+                    AnnotationFunc annotation) {
+  if (!annotation(osrmc_table_block_result(blocks.front())->table())) {
+    return 0;
   }
-  if (radius >= 0.0) {
-    params_typed->radiuses[coordinate_index] = radius;
-  } else {
-    params_typed->radiuses[coordinate_index] = std::nullopt;
+  float* matrix = nullptr;
+  const auto offset = builder.CreateUninitializedVector(rows * cols, &matrix);
+  for (const auto& block : blocks) {
+    const auto* values = annotation(osrmc_table_block_result(block)->table());
+    const size_t block_cols = block.col_end - block.col_begin;
+    for (size_t row = block.row_begin; row < block.row_end; ++row) {
+      std::copy_n(values->data() + (row - block.row_begin) * block_cols,
+                  block_cols,
+                  matrix + row * cols + block.col_begin);
+    }
   }
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return offset;
 }
 
-void
-osrmc_params_get_radius(osrmc_params_t params,
-                        size_t coordinate_index,
-                        double* out_radius,
-                        int* out_is_set,
-                        osrmc_error_t* error) try {
-  if (!out_radius || !out_is_set) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
-    return;
-  }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+// Upper bound of the stitched response size: the full matrices, the blocks the waypoints are copied from and the
+// fallback cells
+static uint64_t
+osrmc_stitched_table_size(const std::vector<osrmc_table_block>& blocks, size_t rows, size_t cols) {
+  const auto* first = osrmc_table_block_result(blocks.front())->table();
+  const uint64_t annotations = (first->durations() ? 1 : 0) + (first->distances() ? 1 : 0);
+  uint64_t size = uint64_t{rows} * cols * sizeof(float) * annotations;
+  for (const auto& block : blocks) {
+    if (block.row_begin == 0 || block.col_begin == 0) {
+      size += std::get<flatbuffers::FlatBufferBuilder>(block.result).GetSize();
+    }
+    if (const auto* cells = osrmc_table_block_result(block)->table()->fallback_speed_cells()) {
+      size += uint64_t{cells->size()} * sizeof(uint32_t);
+    }
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
-    return;
+  return size;
+}
+
+static void
+osrmc_stitch_table(const std::vector<osrmc_table_block>& blocks,
+                   size_t rows,
+                   size_t cols,
+                   osrm::engine::api::ResultT& result) {
+  namespace fbresult = osrm::engine::api::fbresult;
+  // Built in place, so the response uses the allocator of the builder the caller set up
+  if (!std::holds_alternative<flatbuffers::FlatBufferBuilder>(result)) {
+    result = flatbuffers::FlatBufferBuilder();
+  }
+  auto& builder = std::get<flatbuffers::FlatBufferBuilder>(result);
+  const auto* first = osrmc_table_block_result(blocks.front());
+
+  // Sources come from the first block of every block row, destinations from the blocks of the first block row
+  std::vector<const flatbuffers::Vector<flatbuffers::Offset<fbresult::Waypoint>>*> sources;
+  std::vector<const flatbuffers::Vector<flatbuffers::Offset<fbresult::Waypoint>>*> destinations;
+  for (const auto& block : blocks) {
+    const auto* block_result = osrmc_table_block_result(block);
+    if (block.col_begin == 0 && block_result->waypoints()) {
+      sources.push_back(block_result->waypoints());
+    }
+    if (block.row_begin == 0 && block_result->table()->destinations()) {
+      destinations.push_back(block_result->table()->destinations());
+    }
   }
-  if (coordinate_index >= params_typed->radiuses.size() || !params_typed->radiuses[coordinate_index]) {
-    *out_is_set = 0;
-    return;
+  const auto data_version = builder.CreateString(first->data_version());
+  const auto source_waypoints = osrmc_copy_waypoints(builder, sources);
+  const auto destination_waypoints = osrmc_copy_waypoints(builder, destinations);
+
+  // Fallback cells are (row, column) pairs
+  std::vector<uint32_t> fallback_cells;
+  for (const auto& block : blocks) {
+    if (const auto* cells = osrmc_table_block_result(block)->table()->fallback_speed_cells()) {
+      for (flatbuffers::uoffset_t i = 0; i + 1 < cells->size(); i += 2) {
+        fallback_cells.push_back(static_cast<uint32_t>(cells->Get(i) + block.row_begin));
+        fallback_cells.push_back(static_cast<uint32_t>(cells->Get(i + 1) + block.col_begin));
+      }
+    }
   }
-  *out_is_set = 1;
-  *out_radius = *params_typed->radiuses[coordinate_index];
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
+  const auto fallback_speed_cells = builder.CreateVector(fallback_cells);
+  const auto durations =
+    osrmc_stitch_matrix(builder, blocks, rows, cols, [](const fbresult::Table* table) { return table->durations(); });
+  const auto distances =
+    osrmc_stitch_matrix(builder, blocks, rows, cols, [](const fbresult::Table* table) { return table->distances(); });
 
-void
-osrmc_params_set_bearing(osrmc_params_t params,
-                         size_t coordinate_index,
-                         int value,
-                         int range,
-                         osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  fbresult::TableBuilder table(builder);
+  table.add_rows(static_cast<uint16_t>(rows));
+  table.add_cols(static_cast<uint16_t>(cols));
+  if (!durations.IsNull()) {
+    table.add_durations(durations);
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    const std::string message = std::string("Bearing") + " index out of bounds";
-    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
-    return;
+  if (!distances.IsNull()) {
+    table.add_distances(distances);
+  }
+  if (!destinations.empty()) {
+    table.add_destinations(destination_waypoints);
+  }
+  if (!fallback_cells.empty()) {
+    table.add_fallback_speed_cells(fallback_speed_cells);
   }
+  const auto table_offset = table.Finish();
 
-  if (params_typed->bearings.size() < params_typed->coordinates.size()) {
-    params_typed->bearings.resize(params_typed->coordinates.size());
+  fbresult::FBResultBuilder response(builder);
+  if (first->data_version()) {
+    response.add_data_version(data_version);
   }
-  if (value < 0 || range < 0) {
-    params_typed->bearings[coordinate_index] = std::nullopt;
-    return;
+  if (!sources.empty()) {
+    response.add_waypoints(source_waypoints);
   }
+  response.add_table(table_offset);
+  builder.Finish(response.Finish());
+}
 
-  params_typed->bearings[coordinate_index] = osrm::Bearing{static_cast<short>(value), static_cast<short>(range)};
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+// Source or destination indices of a table request; empty lists stand for all coordinates
+static std::vector<size_t>
+osrmc_table_indices(const osrm::TableParameters& params, const std::vector<size_t>& indices) {
+  if (!indices.empty()) {
+    return indices;
+  }
+  std::vector<size_t> all(params.coordinates.size());
+  std::iota(all.begin(), all.end(), size_t{0});
+  return all;
 }
 
-void
-osrmc_params_get_bearing(osrmc_params_t params,
-                         size_t coordinate_index,
-                         int* out_value,
-                         int* out_range,
-                         int* out_is_set,
-                         osrmc_error_t* error) try {
-  if (!out_value || !out_range || !out_is_set) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
-    return;
+// Records the coordinates behind the waypoints of a table response, its sources followed by its destinations
+static void
+osrmc_map_table_waypoints(osrmc_response& response,
+                          size_t coordinate_count,
+                          const size_t* sources,
+                          size_t source_count,
+                          const size_t* destinations,
+                          size_t destination_count) {
+  response.coordinate_count = coordinate_count;
+  response.waypoint_coordinates.assign(sources, sources + source_count);
+  response.waypoint_coordinates.insert(
+    response.waypoint_coordinates.end(), destinations, destinations + destination_count);
+}
+
+// Runs a table request, split into blocks on the worker pool when a tile size is set on its params
+static osrm::Status
+osrmc_table_execute(osrmc_osrm_t osrm,
+                    const osrm::TableParameters& params,
+                    osrm::engine::api::ResultT& result) {
+  const auto [tile_rows, tile_cols] = osrmc_read_controls(&params, [](const osrmc_request_controls& controls) {
+    return std::make_pair(controls.tile_rows, controls.tile_cols);
+  });
+  if (tile_rows == 0 && tile_cols == 0) {
+    return osrm->engine.Table(params, result);
+  }
+  const std::vector<size_t> sources = osrmc_table_indices(params, params.sources);
+  const std::vector<size_t> destinations = osrmc_table_indices(params, params.destinations);
+  const size_t rows = sources.size();
+  const size_t cols = destinations.size();
+  const size_t block_rows = tile_rows > 0 ? tile_rows : rows;
+  const size_t block_cols = tile_cols > 0 ? tile_cols : cols;
+  // Out of range indices and oversized matrices are left to the engine to report
+  const auto in_range = [&params](size_t index) { return index < params.coordinates.size(); };
+  if ((rows <= block_rows && cols <= block_cols) || rows > std::numeric_limits<uint16_t>::max() ||
+      cols > std::numeric_limits<uint16_t>::max() || !std::all_of(sources.begin(), sources.end(), in_range) ||
+      !std::all_of(destinations.begin(), destinations.end(), in_range)) {
+    return osrm->engine.Table(params, result);
+  }
+  // Blocks stay within the engine limit, so the matrix as a whole is held to it unless the operator lifted it
+  const auto max_locations = static_cast<size_t>(std::max(osrm->max_table_locations, 0));
+  if (!osrm->allow_large_tiled_tables && max_locations > 0 && rows * cols > max_locations * max_locations) {
+    result = osrmc_table_failure("TooBig", "Too many table coordinates");
+    return osrm::Status::Error;
+  }
+  // The stitched response is a single FlatBuffer, so matrices beyond its size limit are refused before any block runs
+  if (rows * cols > FLATBUFFERS_MAX_BUFFER_SIZE / osrmc_table_cell_size(params)) {
+    result = osrmc_table_failure("TooBig", "Table response exceeds the FlatBuffers size limit");
+    return osrm::Status::Error;
+  }
+
+  std::vector<osrmc_table_block> blocks;
+  for (size_t row = 0; row < rows; row += block_rows) {
+    for (size_t col = 0; col < cols; col += block_cols) {
+      blocks.push_back(osrmc_table_block{row, std::min(rows, row + block_rows), col, std::min(cols, col + block_cols)});
+    }
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  // The request already holds its slot; blocks run on one more thread for every further slot free right now
+  std::optional<osrmc_slots> slots;
+  const size_t width = osrmc_admit_parallel(osrm, SERVICE_TABLE, &params, true, blocks.size(), slots, nullptr);
+  std::atomic<bool> failed{false};
+  osrmc_parallel_for(
+    &osrm->pool(),
+    blocks.size(),
+    [&](size_t i) {
+      // Remaining blocks are skipped once one fails or the request is cancelled or timed out
+      if (failed.load(std::memory_order_relaxed) || !osrmc_check_controls(&params, nullptr)) {
+        failed.store(true, std::memory_order_relaxed);
+        return;
+      }
+      auto& block = blocks[i];
+      try {
+        block.status = osrm->engine.Table(osrmc_table_block_params(params, sources, destinations, block), block.result);
+      } catch (const std::exception& e) {
+        block.result = osrmc_table_failure("Exception", e.what());
+      }
+      if (block.status != osrm::Status::Ok) {
+        failed.store(true, std::memory_order_relaxed);
+      }
+    },
+    width);
+  slots.reset();
+
+  for (auto& block : blocks) {
+    if (block.status != osrm::Status::Ok && std::holds_alternative<osrm::json::Object>(block.result)) {
+      result = std::move(block.result);
+      return osrm::Status::Error;
+    }
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
-    return;
+  if (failed.load()) {
+    return osrm::Status::Error;
   }
-  if (coordinate_index >= params_typed->bearings.size() || !params_typed->bearings[coordinate_index]) {
-    *out_is_set = 0;
-    return;
+  if (osrmc_stitched_table_size(blocks, rows, cols) > FLATBUFFERS_MAX_BUFFER_SIZE) {
+    result = osrmc_table_failure("TooBig", "Table response exceeds the FlatBuffers size limit");
+    return osrm::Status::Error;
   }
-  *out_is_set = 1;
-  *out_value = params_typed->bearings[coordinate_index]->bearing;
-  *out_range = params_typed->bearings[coordinate_index]->range;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  osrmc_stitch_table(blocks, rows, cols, result);
+  return osrm::Status::Ok;
 }
 
-void
-osrmc_params_set_approach(osrmc_params_t params,
-                          size_t coordinate_index,
-                          approach_t approach,
-                          osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
-  }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    const std::string message = std::string("Approach") + " index out of bounds";
-    osrmc_set_error(error, "InvalidCoordinateIndex", message.c_str());
-    return;
+osrmc_table_response_t
+osrmc_table(osrmc_osrm_t osrm, osrmc_table_params_t params, osrmc_error_t* error) {
+  auto* response = osrmc_service_helper<osrmc_table_params_t, osrm::TableParameters, osrmc_table_response_t>(
+    osrm,
+    params,
+    SERVICE_TABLE,
+    [osrm](osrm::OSRM&, osrm::TableParameters& p, osrm::engine::api::ResultT& r) {
+      return osrmc_table_execute(osrm, p, r);
+    },
+    "TableError",
+    error);
+  if (!response) {
+    return nullptr;
   }
-
-  if (params_typed->approaches.size() < params_typed->coordinates.size()) {
-    params_typed->approaches.resize(params_typed->coordinates.size());
+  try {
+    // Indices were validated by the engine, so every waypoint maps to a coordinate of the request
+    const auto& params_typed = *reinterpret_cast<osrm::TableParameters*>(params);
+    const auto sources = osrmc_table_indices(params_typed, params_typed.sources);
+    const auto destinations = osrmc_table_indices(params_typed, params_typed.destinations);
+    osrmc_map_table_waypoints(*reinterpret_cast<osrmc_response*>(response),
+                              params_typed.coordinates.size(),
+                              sources.data(),
+                              sources.size(),
+                              destinations.data(),
+                              destinations.size());
+  } catch (const std::exception& e) {
+    osrmc_table_response_destruct(response);
+    osrmc_error_from_exception(e, error);
+    return nullptr;
   }
-  std::optional<osrm::engine::Approach> approach_value;
-  switch (approach) {
-    case APPROACH_CURB:
-      approach_value = osrm::engine::Approach::CURB;
-      break;
-    case APPROACH_UNRESTRICTED:
-      approach_value = osrm::engine::Approach::UNRESTRICTED;
-      break;
-    case APPROACH_OPPOSITE:
-      approach_value = osrm::engine::Approach::OPPOSITE;
-      break;
-    default:
-      approach_value = std::nullopt;
-      break;
+  return response;
+}
+
+void
+osrmc_table_response_destruct(osrmc_table_response_t response) {
+  if (response) {
+    osrmc_response_destruct_helper(reinterpret_cast<osrmc_response*>(response));
   }
+}
 
-  params_typed->approaches[coordinate_index] = std::move(approach_value);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+// Streaming table execution
+// Blocks cover whole rows where possible. A block holds at most max_locations_distance_table^2 cells, the product
+// limit the engine enforces, and at most as many cells as fit the memory budget at 4 bytes per annotation.
+static std::pair<size_t, size_t>
+osrmc_table_stream_block_size(const osrmc_osrm& osrm,
+                              const osrm::TableParameters& params,
+                              size_t rows,
+                              size_t cols,
+                              size_t memory_budget) {
+  size_t cells = std::numeric_limits<size_t>::max();
+  if (osrm.max_table_locations > 0) {
+    cells = static_cast<size_t>(osrm.max_table_locations) * static_cast<size_t>(osrm.max_table_locations);
+  }
+  if (memory_budget > 0) {
+    cells = std::min(cells, std::max<size_t>(1, memory_budget / osrmc_table_cell_size(params)));
+  }
+  const size_t block_cols = std::max<size_t>(1, std::min(cols, cells));
+  const size_t block_rows = std::max<size_t>(1, std::min(rows, cells / block_cols));
+  return {block_rows, block_cols};
 }
 
 void
-osrmc_params_get_approach(osrmc_params_t params,
-                          size_t coordinate_index,
-                          approach_t* out_approach,
-                          int* out_is_set,
-                          osrmc_error_t* error) try {
-  if (!out_approach || !out_is_set) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+osrmc_table_stream(osrmc_osrm_t osrm,
+                   osrmc_table_params_t params,
+                   size_t memory_budget,
+                   osrmc_table_block_callback_t callback,
+                   void* userdata,
+                   osrmc_error_t* error) try {
+  if (!osrm) {
+    osrmc_set_error(error, "InvalidArgument", "OSRM instance must not be null");
     return;
   }
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (coordinate_index >= params_typed->coordinates.size()) {
-    osrmc_set_error(error, "InvalidCoordinateIndex", "Coordinate index out of bounds");
+  if (!callback) {
+    osrmc_set_error(error, "InvalidArgument", "Callback must not be null");
     return;
   }
-  if (coordinate_index >= params_typed->approaches.size() || !params_typed->approaches[coordinate_index]) {
-    *out_is_set = 0;
-    return;
+  const auto& params_typed = *reinterpret_cast<osrm::TableParameters*>(params);
+  const std::vector<size_t> sources = osrmc_table_indices(params_typed, params_typed.sources);
+  const std::vector<size_t> destinations = osrmc_table_indices(params_typed, params_typed.destinations);
+  for (const auto& indices : {std::cref(sources), std::cref(destinations)}) {
+    for (const size_t index : indices.get()) {
+      if (index >= params_typed.coordinates.size()) {
+        osrmc_set_error(error, "InvalidIndex", "Source or destination index out of range");
+        return;
+      }
+    }
   }
-  *out_is_set = 1;
-  switch (*params_typed->approaches[coordinate_index]) {
-    case osrm::engine::Approach::CURB:
-      *out_approach = APPROACH_CURB;
-      break;
-    case osrm::engine::Approach::UNRESTRICTED:
-      *out_approach = APPROACH_UNRESTRICTED;
-      break;
-    case osrm::engine::Approach::OPPOSITE:
-      *out_approach = APPROACH_OPPOSITE;
-      break;
+  const size_t rows = sources.size();
+  const size_t cols = destinations.size();
+  const auto [block_rows, block_cols] = osrmc_table_stream_block_size(*osrm, params_typed, rows, cols, memory_budget);
+
+  for (size_t row = 0; row < rows; row += block_rows) {
+    for (size_t col = 0; col < cols; col += block_cols) {
+      // Every block passes admission control on its own, so a long stream does not hold a slot throughout
+      if (!osrmc_check_controls(params, error)) {
+        return;
+      }
+      std::optional<osrmc_slot> slot;
+      if (osrmc_needs_admission(osrm, false)) {
+        if (!osrmc_admission_wait(osrm->scheduler, SERVICE_TABLE, params, error)) {
+          return;
+        }
+        slot.emplace(osrm->scheduler, SERVICE_TABLE);
+      }
+      osrmc_table_block block{row, std::min(rows, row + block_rows), col, std::min(cols, col + block_cols)};
+      const auto status =
+        osrm->engine.Table(osrmc_table_block_params(params_typed, sources, destinations, block), block.result);
+      slot.reset();
+      if (status != osrm::Status::Ok) {
+        osrmc_error_from_result(block.result, "TableError", error);
+        return;
+      }
+
+      // The block response is borrowed by the callback and released before the next block is computed
+      osrmc_response response{std::move(block.result), false, {}, {}, 0};
+      osrmc_map_table_waypoints(response,
+                                params_typed.coordinates.size(),
+                                sources.data() + block.row_begin,
+                                block.row_end - block.row_begin,
+                                destinations.data() + block.col_begin,
+                                block.col_end - block.col_begin);
+      const auto* table = osrm::engine::api::fbresult::GetFBResult(
+                            std::get<flatbuffers::FlatBufferBuilder>(response.result).GetBufferPointer())
+                            ->table();
+      const osrmc_table_block_t view{block.row_begin,
+                                     block.row_end - block.row_begin,
+                                     block.col_begin,
+                                     block.col_end - block.col_begin,
+                                     table->durations() ? table->durations()->data() : nullptr,
+                                     table->distances() ? table->distances()->data() : nullptr,
+                                     reinterpret_cast<osrmc_table_response_t>(&response)};
+      if (callback(&view, userdata) != 0) {
+        return;
+      }
+    }
   }
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_add_exclude(osrmc_params_t params, const char* exclude_profile, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
-  }
-  if (!exclude_profile) {
-    osrmc_set_error(error, "InvalidExclude", "Exclude profile must not be null");
-    return;
-  }
-
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  params_typed->exclude.emplace_back(exclude_profile);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+osrmc_table_batch(osrmc_osrm_t osrm,
+                  const osrmc_table_params_t* params,
+                  size_t n,
+                  osrmc_table_response_t* out,
+                  osrmc_error_t* errors) {
+  osrmc_batch_helper(osrm, params, n, out, errors, SERVICE_TABLE, osrmc_table);
 }
 
 void
-osrmc_params_get_exclude_count(osrmc_params_t params, size_t* out_count, osrmc_error_t* error) try {
-  if (!out_count) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+osrmc_table_response_transfer_flatbuffer(osrmc_table_response_t response,
+                                         uint8_t** data,
+                                         size_t* size,
+                                         void (**deleter)(void*),
+                                         osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    if (data)
+      *data = nullptr;
+    if (size)
+      *size = 0;
+    if (deleter)
+      *deleter = nullptr;
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  if (!data || !size || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  *out_count = params_typed->exclude.size();
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  if (data)
+    *data = nullptr;
+  if (size)
+    *size = 0;
+  if (deleter)
+    *deleter = nullptr;
 }
 
 void
-osrmc_params_get_exclude(osrmc_params_t params,
-                         size_t index,
-                         const char** out_exclude_profile,
-                         osrmc_error_t* error) try {
-  if (!out_exclude_profile) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
-  }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+osrmc_table_response_detach_flatbuffer(osrmc_table_response_t response,
+                                       uint8_t** data,
+                                       size_t* size,
+                                       void** owner,
+                                       void (**deleter)(void*),
+                                       osrmc_error_t* error) try {
+  if (!data || !size || !owner || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  if (index >= params_typed->exclude.size()) {
-    osrmc_set_error(error, "InvalidIndex", "Exclude index out of bounds");
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    *data = nullptr;
+    *size = 0;
+    *owner = nullptr;
+    *deleter = nullptr;
     return;
   }
-  *out_exclude_profile = params_typed->exclude[index].c_str();
+  osrmc_detach_flatbuffer_helper(reinterpret_cast<osrmc_response*>(response), data, size, owner, deleter, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_set_generate_hints(osrmc_params_t params, int on, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+osrmc_table_response_get_hint_count(osrmc_table_response_t response,
+                                    size_t* out_count,
+                                    size_t* out_size,
+                                    osrmc_error_t* error) try {
+  if (!out_count || !out_size) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  params_typed->generate_hints = on != 0;
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    return;
+  }
+  osrmc_response_get_hint_count_helper(reinterpret_cast<osrmc_response*>(response), out_count, out_size, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_params_get_generate_hints(osrmc_params_t params, int* out_on, osrmc_error_t* error) try {
-  if (!out_on) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
-  }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+osrmc_table_response_get_hints(osrmc_table_response_t response,
+                               uint8_t* out_data,
+                               size_t capacity,
+                               size_t* out_sizes,
+                               size_t count,
+                               osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  *out_on = params_typed->generate_hints ? 1 : 0;
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_response_get_hints_helper(resp, out_data, capacity, out_sizes, count, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_params_set_skip_waypoints(osrmc_params_t params, int on, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+// Matrix extraction
+// The stored matrix is row-major float. Column-major output is transposed in square tiles, so neither side is
+// walked with a stride wider than a tile row.
+// OSRM writes unreachable pairs as 0. A route between two different snapped locations never costs 0, so a 0 cell
+// whose source and destination snapped to different locations is unreachable; this needs the waypoints, which
+// responses of skip_waypoints requests lack.
+struct osrmc_matrix_locations final {
+  std::vector<std::pair<float, float>> sources;
+  std::vector<std::pair<float, float>> destinations;
+};
+
+// Snapped locations of the waypoints in `list`; empty unless every one of `count` waypoints has one
+static std::vector<std::pair<float, float>>
+osrmc_waypoint_locations(
+  const flatbuffers::Vector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>>* list,
+  size_t count) {
+  std::vector<std::pair<float, float>> locations;
+  if (!list || list->size() != count) {
+    return locations;
+  }
+  locations.reserve(count);
+  for (const auto* waypoint : *list) {
+    const auto* location = waypoint->location();
+    if (!location) {
+      return {};
+    }
+    locations.emplace_back(location->longitude(), location->latitude());
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  params_typed->skip_waypoints = on != 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return locations;
 }
 
-void
-osrmc_params_get_skip_waypoints(osrmc_params_t params, int* out_on, osrmc_error_t* error) try {
-  if (!out_on) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+// Converts every cell with `convert`; unreachable cells are written as a non-finite cell would be
+template<typename OutputType, typename ConvertFunc>
+static void
+osrmc_copy_matrix(const float* values,
+                  size_t rows,
+                  size_t cols,
+                  matrix_order_t order,
+                  const osrmc_matrix_locations& locations,
+                  OutputType* out,
+                  ConvertFunc convert) {
+  const bool detect = !locations.sources.empty() && !locations.destinations.empty();
+  if (order == MATRIX_ROW_MAJOR && !detect) {
+    std::transform(values, values + rows * cols, out, convert);
+    return;
+  }
+  const OutputType unreachable = convert(std::numeric_limits<float>::quiet_NaN());
+  const auto cell = [&](size_t row, size_t col) -> OutputType {
+    const float value = values[row * cols + col];
+    if (value == 0 && detect && locations.sources[row] != locations.destinations[col]) {
+      return unreachable;
+    }
+    return convert(value);
+  };
+  if (order == MATRIX_ROW_MAJOR) {
+    for (size_t row = 0; row < rows; ++row) {
+      for (size_t col = 0; col < cols; ++col) {
+        out[row * cols + col] = cell(row, col);
+      }
+    }
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  constexpr size_t tile = 64;
+  for (size_t row_begin = 0; row_begin < rows; row_begin += tile) {
+    const size_t row_end = std::min(rows, row_begin + tile);
+    for (size_t col_begin = 0; col_begin < cols; col_begin += tile) {
+      const size_t col_end = std::min(cols, col_begin + tile);
+      for (size_t row = row_begin; row < row_end; ++row) {
+        for (size_t col = col_begin; col < col_end; ++col) {
+          out[col * rows + row] = cell(row, col);
+        }
+      }
+    }
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  *out_on = params_typed->skip_waypoints ? 1 : 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_params_set_snapping(osrmc_params_t params, snapping_t snapping, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+// Looks up the `annotation` matrix of a table response and checks it against the caller's dimensions. Every table
+// response records its row and column count, stitched ones included, as tiling never builds more than 65535 of
+// either.
+template<typename AnnotationFunc>
+static const float*
+osrmc_table_response_matrix(osrmc_table_response_t response,
+                            size_t rows,
+                            size_t cols,
+                            const char* name,
+                            AnnotationFunc annotation,
+                            osrmc_error_t* error) {
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  if (!std::holds_alternative<flatbuffers::FlatBufferBuilder>(resp->result)) {
+    osrmc_set_error(error, "InvalidFormat", "Response is not in FlatBuffer format");
+    return nullptr;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  switch (snapping) {
-    case SNAPPING_DEFAULT:
-      params_typed->snapping = osrm::engine::api::BaseParameters::SnappingType::Default;
-      break;
-    case SNAPPING_ANY:
-      params_typed->snapping = osrm::engine::api::BaseParameters::SnappingType::Any;
-      break;
-    default:
-      osrmc_set_error(error, "InvalidSnapping", "Unknown snapping type");
-      return;
+  const auto& builder = std::get<flatbuffers::FlatBufferBuilder>(resp->result);
+  const auto* table = osrm::engine::api::fbresult::GetFBResult(builder.GetBufferPointer())->table();
+  const flatbuffers::Vector<float>* values = table ? annotation(table) : nullptr;
+  if (!values) {
+    osrmc_set_error(error, "InvalidArgument", (std::string("Response has no ") + name).c_str());
+    return nullptr;
   }
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  if (table->rows() != rows || table->cols() != cols || values->size() != rows * cols) {
+    osrmc_set_error(error, "InvalidArgument", "Matrix size does not match the response");
+    return nullptr;
+  }
+  return values->data();
 }
 
-void
-osrmc_params_get_snapping(osrmc_params_t params, snapping_t* out_snapping, osrmc_error_t* error) try {
-  if (!out_snapping) {
+template<typename OutputType, typename AnnotationFunc, typename ConvertFunc>
+static void
+osrmc_table_response_get_matrix_helper(osrmc_table_response_t response,
+                                       OutputType* out,
+                                       size_t rows,
+                                       size_t cols,
+                                       matrix_order_t order,
+                                       const char* name,
+                                       AnnotationFunc annotation,
+                                       ConvertFunc convert,
+                                       osrmc_error_t* error) {
+  if (!out && rows * cols > 0) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::engine::api::BaseParameters*>(params);
-  switch (params_typed->snapping) {
-    case osrm::engine::api::BaseParameters::SnappingType::Default:
-      *out_snapping = SNAPPING_DEFAULT;
-      break;
-    case osrm::engine::api::BaseParameters::SnappingType::Any:
-      *out_snapping = SNAPPING_ANY;
-      break;
+  if (order != MATRIX_ROW_MAJOR && order != MATRIX_COLUMN_MAJOR) {
+    osrmc_set_error(error, "InvalidArgument", "Invalid matrix order");
+    return;
   }
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  const float* values = osrmc_table_response_matrix(response, rows, cols, name, annotation, error);
+  if (!values) {
+    return;
+  }
+  const auto& builder = std::get<flatbuffers::FlatBufferBuilder>(reinterpret_cast<osrmc_response*>(response)->result);
+  const auto* result = osrm::engine::api::fbresult::GetFBResult(builder.GetBufferPointer());
+  const osrmc_matrix_locations locations{osrmc_waypoint_locations(result->waypoints(), rows),
+                                         osrmc_waypoint_locations(result->table()->destinations(), cols)};
+  osrmc_copy_matrix(values, rows, cols, order, locations, out, convert);
 }
 
+template<typename FloatType>
+static FloatType
+osrmc_matrix_to_float(float value) {
+  return std::isfinite(value) ? static_cast<FloatType>(value) : std::numeric_limits<FloatType>::quiet_NaN();
+}
 
-/* Nearest */
+// Quantized cells saturate one below the sentinel, so a reachable pair never reads as unreachable
+static auto
+osrmc_matrix_to_uint32(double scale) {
+  return [scale](float value) -> uint32_t {
+    if (!std::isfinite(value)) {
+      return OSRMC_MATRIX_UNREACHABLE;
+    }
+    const double scaled = std::round(static_cast<double>(value) * scale);
+    constexpr double max_value = static_cast<double>(OSRMC_MATRIX_UNREACHABLE - 1);
+    return static_cast<uint32_t>(std::clamp(scaled, 0.0, max_value));
+  };
+}
 
-osrmc_nearest_params_t
-osrmc_nearest_params_construct(osrmc_error_t* error) try {
-  auto* out = new osrm::NearestParameters;
-  // Always set FlatBuffer format
-  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
-  return reinterpret_cast<osrmc_nearest_params_t>(out);
+static bool
+osrmc_is_valid_matrix_scale(double scale, osrmc_error_t* error) {
+  if (!std::isfinite(scale) || scale <= 0) {
+    osrmc_set_error(error, "InvalidArgument", "Scale must be positive and finite");
+    return false;
+  }
+  return true;
+}
+
+void
+osrmc_table_response_get_durations(osrmc_table_response_t response,
+                                   double* out,
+                                   size_t rows,
+                                   size_t cols,
+                                   matrix_order_t order,
+                                   osrmc_error_t* error) try {
+  osrmc_table_response_get_matrix_helper(response,
+                                         out,
+                                         rows,
+                                         cols,
+                                         order,
+                                         "durations",
+                                         [](const auto* table) { return table->durations(); },
+                                         osrmc_matrix_to_float<double>,
+                                         error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  return nullptr;
 }
 
 void
-osrmc_nearest_params_destruct(osrmc_nearest_params_t params) {
-  if (params) {
-    delete reinterpret_cast<osrm::NearestParameters*>(params);
-  }
+osrmc_table_response_get_distances(osrmc_table_response_t response,
+                                   double* out,
+                                   size_t rows,
+                                   size_t cols,
+                                   matrix_order_t order,
+                                   osrmc_error_t* error) try {
+  osrmc_table_response_get_matrix_helper(response,
+                                         out,
+                                         rows,
+                                         cols,
+                                         order,
+                                         "distances",
+                                         [](const auto* table) { return table->distances(); },
+                                         osrmc_matrix_to_float<double>,
+                                         error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_nearest_params_set_number_of_results(osrmc_nearest_params_t params, unsigned n, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
-  }
-  auto* params_typed = reinterpret_cast<osrm::NearestParameters*>(params);
-  params_typed->number_of_results = n;
+osrmc_table_response_get_durations_float32(osrmc_table_response_t response,
+                                           float* out,
+                                           size_t rows,
+                                           size_t cols,
+                                           matrix_order_t order,
+                                           osrmc_error_t* error) try {
+  osrmc_table_response_get_matrix_helper(response,
+                                         out,
+                                         rows,
+                                         cols,
+                                         order,
+                                         "durations",
+                                         [](const auto* table) { return table->durations(); },
+                                         osrmc_matrix_to_float<float>,
+                                         error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_table_response_get_distances_float32(osrmc_table_response_t response,
+                                           float* out,
+                                           size_t rows,
+                                           size_t cols,
+                                           matrix_order_t order,
+                                           osrmc_error_t* error) try {
+  osrmc_table_response_get_matrix_helper(response,
+                                         out,
+                                         rows,
+                                         cols,
+                                         order,
+                                         "distances",
+                                         [](const auto* table) { return table->distances(); },
+                                         osrmc_matrix_to_float<float>,
+                                         error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_nearest_params_get_number_of_results(osrmc_nearest_params_t params, unsigned* out_n, osrmc_error_t* error) try {
-  if (!out_n) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+osrmc_table_response_get_durations_uint32(osrmc_table_response_t response,
+                                          uint32_t* out,
+                                          size_t rows,
+                                          size_t cols,
+                                          matrix_order_t order,
+                                          double scale,
+                                          osrmc_error_t* error) try {
+  if (!osrmc_is_valid_matrix_scale(scale, error)) {
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  osrmc_table_response_get_matrix_helper(response,
+                                         out,
+                                         rows,
+                                         cols,
+                                         order,
+                                         "durations",
+                                         [](const auto* table) { return table->durations(); },
+                                         osrmc_matrix_to_uint32(scale),
+                                         error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_table_response_get_distances_uint32(osrmc_table_response_t response,
+                                          uint32_t* out,
+                                          size_t rows,
+                                          size_t cols,
+                                          matrix_order_t order,
+                                          double scale,
+                                          osrmc_error_t* error) try {
+  if (!osrmc_is_valid_matrix_scale(scale, error)) {
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::NearestParameters*>(params);
-  *out_n = params_typed->number_of_results;
+  osrmc_table_response_get_matrix_helper(response,
+                                         out,
+                                         rows,
+                                         cols,
+                                         order,
+                                         "distances",
+                                         [](const auto* table) { return table->distances(); },
+                                         osrmc_matrix_to_uint32(scale),
+                                         error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-osrmc_nearest_response_t
-osrmc_nearest(osrmc_osrm_t osrm, osrmc_nearest_params_t params, osrmc_error_t* error) {
-  return osrmc_service_helper<osrmc_nearest_params_t, osrm::NearestParameters, osrmc_nearest_response_t>(
-    osrm,
-    params,
-    [](osrm::OSRM& o, osrm::NearestParameters& p, osrm::engine::api::ResultT& r) { return o.Nearest(p, r); },
-    "NearestError",
-    error);
+/* Match */
+
+osrmc_match_params_t
+osrmc_match_params_construct(osrmc_error_t* error) try {
+  auto* out = osrmc_new_params<osrm::MatchParameters>();
+  // Always set FlatBuffer format
+  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
+  return reinterpret_cast<osrmc_match_params_t>(out);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
 void
-osrmc_nearest_response_destruct(osrmc_nearest_response_t response) {
-  if (response) {
-    delete reinterpret_cast<osrmc_response*>(response);
+osrmc_match_params_destruct(osrmc_match_params_t params) {
+  if (params) {
+    osrmc_delete_params(reinterpret_cast<osrm::MatchParameters*>(params));
   }
 }
 
 void
-osrmc_nearest_response_transfer_flatbuffer(osrmc_nearest_response_t response,
-                                           uint8_t** data,
-                                           size_t* size,
-                                           void (**deleter)(void*),
-                                           osrmc_error_t* error) try {
-  if (!response) {
-    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
-    if (data)
-      *data = nullptr;
-    if (size)
-      *size = 0;
-    if (deleter)
-      *deleter = nullptr;
-    return;
-  }
-  if (!data || !size || !deleter) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+osrmc_match_params_reset(osrmc_match_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* resp = reinterpret_cast<osrmc_response*>(response);
-  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  osrmc_reset_params_helper(*params_typed);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  if (data)
-    *data = nullptr;
-  if (size)
-    *size = 0;
-  if (deleter)
-    *deleter = nullptr;
 }
 
-/* Route */
-
-osrmc_route_params_t
-osrmc_route_params_construct(osrmc_error_t* error) try {
-  auto* out = new osrm::RouteParameters;
-  // Always set FlatBuffer format
-  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
-  return reinterpret_cast<osrmc_route_params_t>(out);
+osrmc_match_params_t
+osrmc_match_params_clone(osrmc_match_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return nullptr;
+  }
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* out = osrmc_new_params<osrm::MatchParameters>(*params_typed);
+  return reinterpret_cast<osrmc_match_params_t>(out);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
   return nullptr;
 }
 
 void
-osrmc_route_params_destruct(osrmc_route_params_t params) {
-  if (params) {
-    delete reinterpret_cast<osrm::RouteParameters*>(params);
+osrmc_match_params_apply_template(osrmc_match_params_t params,
+                                  osrmc_match_params_t template_params,
+                                  osrmc_error_t* error) try {
+  if (!params || !template_params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
   }
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* template_typed = reinterpret_cast<osrm::MatchParameters*>(template_params);
+  osrmc_apply_template_helper(*params_typed, *template_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_set_steps(osrmc_route_params_t params, int on, osrmc_error_t* error) try {
+osrmc_match_params_set_steps(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   params_typed->steps = on != 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_get_steps(osrmc_route_params_t params, int* out_on, osrmc_error_t* error) try {
+osrmc_match_params_get_steps(osrmc_match_params_t params, int* out_on, osrmc_error_t* error) try {
   if (!out_on) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -1425,26 +6387,26 @@ osrmc_route_params_get_steps(osrmc_route_params_t params, int* out_on, osrmc_err
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   *out_on = params_typed->steps ? 1 : 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_set_alternatives(osrmc_route_params_t params, int on, osrmc_error_t* error) try {
+osrmc_match_params_set_alternatives(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   params_typed->alternatives = on != 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_get_alternatives(osrmc_route_params_t params, int* out_on, osrmc_error_t* error) try {
+osrmc_match_params_get_alternatives(osrmc_match_params_t params, int* out_on, osrmc_error_t* error) try {
   if (!out_on) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -1453,19 +6415,19 @@ osrmc_route_params_get_alternatives(osrmc_route_params_t params, int* out_on, os
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   *out_on = params_typed->alternatives ? 1 : 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_set_geometries(osrmc_route_params_t params, geometries_type_t geometries, osrmc_error_t* error) try {
+osrmc_match_params_set_geometries(osrmc_match_params_t params, geometries_type_t geometries, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   switch (geometries) {
     case GEOMETRIES_POLYLINE:
       params_typed->geometries = osrm::RouteParameters::GeometriesType::Polyline;
@@ -1485,7 +6447,7 @@ osrmc_route_params_set_geometries(osrmc_route_params_t params, geometries_type_t
 }
 
 void
-osrmc_route_params_get_geometries(osrmc_route_params_t params,
+osrmc_match_params_get_geometries(osrmc_match_params_t params,
                                   geometries_type_t* out_geometries,
                                   osrmc_error_t* error) try {
   if (!out_geometries) {
@@ -1496,7 +6458,7 @@ osrmc_route_params_get_geometries(osrmc_route_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   switch (params_typed->geometries) {
     case osrm::RouteParameters::GeometriesType::Polyline:
       *out_geometries = GEOMETRIES_POLYLINE;
@@ -1513,12 +6475,12 @@ osrmc_route_params_get_geometries(osrmc_route_params_t params,
 }
 
 void
-osrmc_route_params_set_overview(osrmc_route_params_t params, overview_type_t overview, osrmc_error_t* error) try {
+osrmc_match_params_set_overview(osrmc_match_params_t params, overview_type_t overview, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   switch (overview) {
     case OVERVIEW_SIMPLIFIED:
       params_typed->overview = osrm::RouteParameters::OverviewType::Simplified;
@@ -1538,7 +6500,7 @@ osrmc_route_params_set_overview(osrmc_route_params_t params, overview_type_t ove
 }
 
 void
-osrmc_route_params_get_overview(osrmc_route_params_t params, overview_type_t* out_overview, osrmc_error_t* error) try {
+osrmc_match_params_get_overview(osrmc_match_params_t params, overview_type_t* out_overview, osrmc_error_t* error) try {
   if (!out_overview) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -1547,7 +6509,7 @@ osrmc_route_params_get_overview(osrmc_route_params_t params, overview_type_t* ou
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   switch (params_typed->overview) {
     case osrm::RouteParameters::OverviewType::Simplified:
       *out_overview = OVERVIEW_SIMPLIFIED;
@@ -1564,12 +6526,12 @@ osrmc_route_params_get_overview(osrmc_route_params_t params, overview_type_t* ou
 }
 
 void
-osrmc_route_params_set_continue_straight(osrmc_route_params_t params, int on, osrmc_error_t* error) try {
+osrmc_match_params_set_continue_straight(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   if (on < 0) {
     params_typed->continue_straight = std::nullopt;
   } else {
@@ -1580,7 +6542,7 @@ osrmc_route_params_set_continue_straight(osrmc_route_params_t params, int on, os
 }
 
 void
-osrmc_route_params_get_continue_straight(osrmc_route_params_t params,
+osrmc_match_params_get_continue_straight(osrmc_match_params_t params,
                                          int* out_on,
                                          int* out_is_set,
                                          osrmc_error_t* error) try {
@@ -1592,7 +6554,7 @@ osrmc_route_params_get_continue_straight(osrmc_route_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   if (!params_typed->continue_straight) {
     *out_is_set = 0;
     return;
@@ -1604,12 +6566,12 @@ osrmc_route_params_get_continue_straight(osrmc_route_params_t params,
 }
 
 void
-osrmc_route_params_set_number_of_alternatives(osrmc_route_params_t params, unsigned count, osrmc_error_t* error) try {
+osrmc_match_params_set_number_of_alternatives(osrmc_match_params_t params, unsigned count, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   params_typed->number_of_alternatives = count;
   params_typed->alternatives = count > 0;
 } catch (const std::exception& e) {
@@ -1617,7 +6579,7 @@ osrmc_route_params_set_number_of_alternatives(osrmc_route_params_t params, unsig
 }
 
 void
-osrmc_route_params_get_number_of_alternatives(osrmc_route_params_t params,
+osrmc_match_params_get_number_of_alternatives(osrmc_match_params_t params,
                                               unsigned* out_count,
                                               osrmc_error_t* error) try {
   if (!out_count) {
@@ -1628,21 +6590,21 @@ osrmc_route_params_get_number_of_alternatives(osrmc_route_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   *out_count = params_typed->number_of_alternatives;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_set_annotations(osrmc_route_params_t params,
+osrmc_match_params_set_annotations(osrmc_match_params_t params,
                                    annotations_type_t annotations,
                                    osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   params_typed->annotations_type = static_cast<osrm::RouteParameters::AnnotationsType>(annotations);
   params_typed->annotations = (annotations != ANNOTATIONS_NONE);
 } catch (const std::exception& e) {
@@ -1650,7 +6612,7 @@ osrmc_route_params_set_annotations(osrmc_route_params_t params,
 }
 
 void
-osrmc_route_params_get_annotations(osrmc_route_params_t params,
+osrmc_match_params_get_annotations(osrmc_match_params_t params,
                                    annotations_type_t* out_annotations,
                                    osrmc_error_t* error) try {
   if (!out_annotations) {
@@ -1661,26 +6623,26 @@ osrmc_route_params_get_annotations(osrmc_route_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   *out_annotations = static_cast<annotations_type_t>(params_typed->annotations_type);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_add_waypoint(osrmc_route_params_t params, size_t index, osrmc_error_t* error) try {
+osrmc_match_params_add_waypoint(osrmc_match_params_t params, size_t index, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   params_typed->waypoints.emplace_back(index);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_get_waypoint_count(osrmc_route_params_t params, size_t* out_count, osrmc_error_t* error) try {
+osrmc_match_params_get_waypoint_count(osrmc_match_params_t params, size_t* out_count, osrmc_error_t* error) try {
   if (!out_count) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -1689,14 +6651,14 @@ osrmc_route_params_get_waypoint_count(osrmc_route_params_t params, size_t* out_c
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   *out_count = params_typed->waypoints.size();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_params_get_waypoint(osrmc_route_params_t params,
+osrmc_match_params_get_waypoint(osrmc_match_params_t params,
                                 size_t index,
                                 size_t* out_index,
                                 osrmc_error_t* error) try {
@@ -1708,7 +6670,7 @@ osrmc_route_params_get_waypoint(osrmc_route_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   if (index >= params_typed->waypoints.size()) {
     osrmc_set_error(error, "InvalidIndex", "Waypoint index out of bounds");
     return;
@@ -1719,117 +6681,153 @@ osrmc_route_params_get_waypoint(osrmc_route_params_t params,
 }
 
 void
-osrmc_route_params_clear_waypoints(osrmc_route_params_t params, osrmc_error_t* error) try {
+osrmc_match_params_clear_waypoints(osrmc_match_params_t params, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::RouteParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
   params_typed->waypoints.clear();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-osrmc_route_response_t
-osrmc_route(osrmc_osrm_t osrm, osrmc_route_params_t params, osrmc_error_t* error) {
-  return osrmc_service_helper<osrmc_route_params_t, osrm::RouteParameters, osrmc_route_response_t>(
-    osrm,
-    params,
-    [](osrm::OSRM& o, osrm::RouteParameters& p, osrm::engine::api::ResultT& r) { return o.Route(p, r); },
-    "RouteError",
-    error);
+void
+osrmc_match_params_set_waypoints(osrmc_match_params_t params,
+                                 const size_t* indices,
+                                 size_t count,
+                                 osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !indices) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  params_typed->waypoints.assign(indices, indices + count);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_response_destruct(osrmc_route_response_t response) {
-  if (response) {
-    delete reinterpret_cast<osrmc_response*>(response);
+osrmc_match_params_add_timestamp(osrmc_match_params_t params, unsigned timestamp, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
   }
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  params_typed->timestamps.emplace_back(timestamp);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_route_response_transfer_flatbuffer(osrmc_route_response_t response,
-                                         uint8_t** data,
-                                         size_t* size,
-                                         void (**deleter)(void*),
-                                         osrmc_error_t* error) try {
-  if (!response) {
-    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
-    if (data)
-      *data = nullptr;
-    if (size)
-      *size = 0;
-    if (deleter)
-      *deleter = nullptr;
+osrmc_match_params_get_timestamp_count(osrmc_match_params_t params, size_t* out_count, osrmc_error_t* error) try {
+  if (!out_count) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!data || !size || !deleter) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* resp = reinterpret_cast<osrmc_response*>(response);
-  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  *out_count = params_typed->timestamps.size();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  if (data)
-    *data = nullptr;
-  if (size)
-    *size = 0;
-  if (deleter)
-    *deleter = nullptr;
 }
 
-/* Table */
-
-osrmc_table_params_t
-osrmc_table_params_construct(osrmc_error_t* error) try {
-  auto* out = new osrm::TableParameters;
-  // Always set FlatBuffer format
-  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
-  return reinterpret_cast<osrmc_table_params_t>(out);
+void
+osrmc_match_params_get_timestamp(osrmc_match_params_t params,
+                                 size_t index,
+                                 unsigned* out_timestamp,
+                                 osrmc_error_t* error) try {
+  if (!out_timestamp) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  if (index >= params_typed->timestamps.size()) {
+    osrmc_set_error(error, "InvalidIndex", "Timestamp index out of bounds");
+    return;
+  }
+  *out_timestamp = params_typed->timestamps[index];
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  return nullptr;
 }
 
 void
-osrmc_table_params_destruct(osrmc_table_params_t params) {
-  if (params) {
-    delete reinterpret_cast<osrm::TableParameters*>(params);
+osrmc_match_params_set_timestamps(osrmc_match_params_t params,
+                                  const unsigned* timestamps,
+                                  size_t count,
+                                  osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !timestamps) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
   }
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  params_typed->timestamps.assign(timestamps, timestamps + count);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_add_source(osrmc_table_params_t params, size_t index, osrmc_error_t* error) try {
+osrmc_match_params_set_timestamps_epoch(osrmc_match_params_t params,
+                                        const int64_t* epoch_seconds,
+                                        size_t count,
+                                        osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  params_typed->sources.emplace_back(index);
+  if (count > 0 && !epoch_seconds) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  // Validate up front so out-of-range input leaves the params untouched
+  constexpr auto max_timestamp = static_cast<std::int64_t>(std::numeric_limits<unsigned>::max());
+  for (size_t i = 0; i < count; ++i) {
+    if (epoch_seconds[i] < 0 || epoch_seconds[i] > max_timestamp) {
+      const std::string message = "Timestamp " + std::to_string(i) + " does not fit into 32 bit unsigned seconds";
+      osrmc_set_error(error, "InvalidTimestamp", message.c_str());
+      return;
+    }
+  }
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto& timestamps = params_typed->timestamps;
+  timestamps.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    timestamps[i] = static_cast<unsigned>(epoch_seconds[i]);
+  }
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_get_source_count(osrmc_table_params_t params, size_t* out_count, osrmc_error_t* error) try {
-  if (!out_count) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
-  }
+osrmc_match_params_set_gaps(osrmc_match_params_t params, match_gaps_type_t gaps, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  *out_count = params_typed->sources.size();
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  params_typed->gaps = static_cast<osrm::MatchParameters::GapsType>(gaps);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_get_source(osrmc_table_params_t params, size_t index, size_t* out_index, osrmc_error_t* error) try {
-  if (!out_index) {
+osrmc_match_params_get_gaps(osrmc_match_params_t params, match_gaps_type_t* out_gaps, osrmc_error_t* error) try {
+  if (!out_gaps) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -1837,31 +6835,27 @@ osrmc_table_params_get_source(osrmc_table_params_t params, size_t index, size_t*
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  if (index >= params_typed->sources.size()) {
-    osrmc_set_error(error, "InvalidIndex", "Source index out of bounds");
-    return;
-  }
-  *out_index = params_typed->sources[index];
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  *out_gaps = static_cast<match_gaps_type_t>(params_typed->gaps);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_add_destination(osrmc_table_params_t params, size_t index, osrmc_error_t* error) try {
+osrmc_match_params_set_tidy(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  params_typed->destinations.emplace_back(index);
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  params_typed->tidy = on != 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_get_destination_count(osrmc_table_params_t params, size_t* out_count, osrmc_error_t* error) try {
-  if (!out_count) {
+osrmc_match_params_get_tidy(osrmc_match_params_t params, int* out_on, osrmc_error_t* error) try {
+  if (!out_on) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -1869,157 +6863,285 @@ osrmc_table_params_get_destination_count(osrmc_table_params_t params, size_t* ou
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  *out_count = params_typed->destinations.size();
+  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  *out_on = params_typed->tidy ? 1 : 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
+osrmc_match_response_t
+osrmc_match(osrmc_osrm_t osrm, osrmc_match_params_t params, osrmc_error_t* error) {
+  return osrmc_service_helper<osrmc_match_params_t, osrm::MatchParameters, osrmc_match_response_t>(
+    osrm,
+    params,
+    SERVICE_MATCH,
+    [](osrm::OSRM& o, osrm::MatchParameters& p, osrm::engine::api::ResultT& r) { return o.Match(p, r); },
+    "MatchError",
+    error);
+}
+
 void
-osrmc_table_params_get_destination(osrmc_table_params_t params,
-                                   size_t index,
-                                   size_t* out_index,
-                                   osrmc_error_t* error) try {
-  if (!out_index) {
+osrmc_match_response_destruct(osrmc_match_response_t response) {
+  if (response) {
+    osrmc_response_destruct_helper(reinterpret_cast<osrmc_response*>(response));
+  }
+}
+
+void
+osrmc_match_batch(osrmc_osrm_t osrm,
+                  const osrmc_match_params_t* params,
+                  size_t n,
+                  osrmc_match_response_t* out,
+                  osrmc_error_t* errors) {
+  osrmc_batch_helper(osrm, params, n, out, errors, SERVICE_MATCH, osrmc_match);
+}
+
+size_t
+osrmc_match_traces(osrmc_osrm_t osrm,
+                   osrmc_match_params_t template_params,
+                   const uint64_t* trace_ids,
+                   const double* longitudes,
+                   const double* latitudes,
+                   const int64_t* timestamps,
+                   size_t count,
+                   osrmc_match_response_t* out,
+                   osrmc_error_t* errors,
+                   size_t capacity,
+                   osrmc_error_t* error) try {
+  const bool granted = std::exchange(osrmc_slot_granted, false);
+  if (!out) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+    return 0;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (count > 0 && (!trace_ids || !longitudes || !latitudes)) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointers must not be null");
+    return 0;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  if (index >= params_typed->destinations.size()) {
-    osrmc_set_error(error, "InvalidIndex", "Destination index out of bounds");
-    return;
+
+  // A trace is a run of rows with the same id
+  std::vector<std::pair<size_t, size_t>> traces;
+  for (size_t row = 0; row < count; ++row) {
+    if (row == 0 || trace_ids[row] != trace_ids[row - 1]) {
+      traces.emplace_back(row, row);
+    }
+    ++traces.back().second;
   }
-  *out_index = params_typed->destinations[index];
+  if (traces.size() > capacity) {
+    osrmc_set_error(error, "InvalidArgument", "Trace count exceeds output capacity");
+    return 0;
+  }
+
+  // Items are claimed in order, so starting with the longest traces keeps a few long ones from finishing last
+  std::vector<size_t> order(traces.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&traces](size_t a, size_t b) {
+    return traces[a].second - traces[a].first > traces[b].second - traces[b].first;
+  });
+
+  osrm::MatchParameters defaults;
+  defaults.format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
+  const auto& options = template_params ? *reinterpret_cast<osrm::MatchParameters*>(template_params) : defaults;
+  // Tenant and response allocator of the template carry over to every trace
+  uint32_t tenant = 0;
+  std::optional<osrmc_allocator_t> allocator;
+  if (template_params) {
+    std::tie(tenant, allocator) = osrmc_read_controls(template_params, [](const osrmc_request_controls& controls) {
+      return std::make_pair(controls.tenant, controls.allocator);
+    });
+  }
+  // All traces are admitted together, as one request of the template
+  std::optional<osrmc_slots> slots;
+  size_t width = order.size();
+  if (!order.empty()) {
+    width = osrmc_admit_parallel(osrm, SERVICE_MATCH, template_params, granted, order.size(), slots, error);
+    if (width == 0) {
+      return 0;
+    }
+  }
+  osrmc_parallel_for(
+    osrmc_pool_or_null(osrm),
+    order.size(),
+    [&](size_t item) {
+      const size_t i = order[item];
+      osrmc_error_t* trace_error = errors ? &errors[i] : nullptr;
+      if (trace_error) {
+        *trace_error = nullptr;
+      }
+      out[i] = nullptr;
+      // Deadline and cancellation token of the template apply to the whole call
+      if (template_params && !osrmc_check_controls(template_params, trace_error)) {
+        return;
+      }
+      const auto [first, last] = traces[i];
+      try {
+        const osrmc_params_ptr<osrm::MatchParameters> trace(osrmc_new_params<osrm::MatchParameters>());
+        osrmc_apply_template_helper(*trace, options);
+        osrmc_update_controls(trace.get(), [&](osrmc_request_controls& controls) {
+          controls.tenant = tenant;
+          controls.allocator = allocator;
+        });
+        auto* handle = reinterpret_cast<osrmc_match_params_t>(trace.get());
+        osrmc_error_t local_error = nullptr;
+        osrmc_params_add_coordinates(
+          reinterpret_cast<osrmc_params_t>(handle), longitudes + first, latitudes + first, last - first, &local_error);
+        if (!local_error && timestamps) {
+          osrmc_match_params_set_timestamps_epoch(handle, timestamps + first, last - first, &local_error);
+        }
+        if (local_error) {
+          if (trace_error) {
+            *trace_error = local_error;
+          } else {
+            osrmc_error_destruct(local_error);
+          }
+          return;
+        }
+        // Traces run within the slots of the call
+        osrmc_slot_granted = slots.has_value();
+        out[i] = osrmc_match(osrm, handle, trace_error);
+        osrmc_slot_granted = false;
+      } catch (const std::exception& e) {
+        osrmc_error_from_exception(e, trace_error);
+      }
+    },
+    width);
+  return traces.size();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return 0;
 }
 
 void
-osrmc_table_params_set_annotations(osrmc_table_params_t params,
-                                   table_annotations_type_t annotations,
-                                   osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+osrmc_match_response_transfer_flatbuffer(osrmc_match_response_t response,
+                                         uint8_t** data,
+                                         size_t* size,
+                                         void (**deleter)(void*),
+                                         osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    if (data)
+      *data = nullptr;
+    if (size)
+      *size = 0;
+    if (deleter)
+      *deleter = nullptr;
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  switch (annotations) {
-    case TABLE_ANNOTATIONS_NONE:
-      params_typed->annotations = osrm::TableParameters::AnnotationsType::None;
-      break;
-    case TABLE_ANNOTATIONS_DURATION:
-      params_typed->annotations = osrm::TableParameters::AnnotationsType::Duration;
-      break;
-    case TABLE_ANNOTATIONS_DISTANCE:
-      params_typed->annotations = osrm::TableParameters::AnnotationsType::Distance;
-      break;
-    case TABLE_ANNOTATIONS_ALL:
-      params_typed->annotations = osrm::TableParameters::AnnotationsType::All;
-      break;
-    default:
-      osrmc_set_error(error, "InvalidArgument", "Unknown annotations type");
-      return;
+  if (!data || !size || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+    return;
   }
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  if (data)
+    *data = nullptr;
+  if (size)
+    *size = 0;
+  if (deleter)
+    *deleter = nullptr;
 }
 
 void
-osrmc_table_params_get_annotations(osrmc_table_params_t params,
-                                   table_annotations_type_t* out_annotations,
-                                   osrmc_error_t* error) try {
-  if (!out_annotations) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+osrmc_match_response_detach_flatbuffer(osrmc_match_response_t response,
+                                       uint8_t** data,
+                                       size_t* size,
+                                       void** owner,
+                                       void (**deleter)(void*),
+                                       osrmc_error_t* error) try {
+  if (!data || !size || !owner || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    *data = nullptr;
+    *size = 0;
+    *owner = nullptr;
+    *deleter = nullptr;
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  switch (params_typed->annotations) {
-    case osrm::TableParameters::AnnotationsType::None:
-      *out_annotations = TABLE_ANNOTATIONS_NONE;
-      break;
-    case osrm::TableParameters::AnnotationsType::Duration:
-      *out_annotations = TABLE_ANNOTATIONS_DURATION;
-      break;
-    case osrm::TableParameters::AnnotationsType::Distance:
-      *out_annotations = TABLE_ANNOTATIONS_DISTANCE;
-      break;
-    case osrm::TableParameters::AnnotationsType::All:
-      *out_annotations = TABLE_ANNOTATIONS_ALL;
-      break;
-  }
+  osrmc_detach_flatbuffer_helper(reinterpret_cast<osrmc_response*>(response), data, size, owner, deleter, error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+/* Trip */
+
+osrmc_trip_params_t
+osrmc_trip_params_construct(osrmc_error_t* error) try {
+  auto* out = osrmc_new_params<osrm::TripParameters>();
+  // Always set FlatBuffer format
+  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
+  return reinterpret_cast<osrmc_trip_params_t>(out);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
 void
-osrmc_table_params_set_fallback_speed(osrmc_table_params_t params, double speed, osrmc_error_t* error) try {
+osrmc_trip_params_destruct(osrmc_trip_params_t params) {
+  if (params) {
+    osrmc_delete_params(reinterpret_cast<osrm::TripParameters*>(params));
+  }
+}
+
+void
+osrmc_trip_params_reset(osrmc_trip_params_t params, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  if (speed <= 0) {
-    osrmc_set_error(error, "InvalidArgument", "Fallback speed must be positive");
-    return;
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  osrmc_reset_params_helper(*params_typed);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+osrmc_trip_params_t
+osrmc_trip_params_clone(osrmc_trip_params_t params, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return nullptr;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  params_typed->fallback_speed = speed;
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  auto* out = osrmc_new_params<osrm::TripParameters>(*params_typed);
+  return reinterpret_cast<osrmc_trip_params_t>(out);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
 void
-osrmc_table_params_get_fallback_speed(osrmc_table_params_t params, double* out_speed, osrmc_error_t* error) try {
-  if (!out_speed) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
-  }
-  if (!params) {
+osrmc_trip_params_apply_template(osrmc_trip_params_t params,
+                                 osrmc_trip_params_t template_params,
+                                 osrmc_error_t* error) try {
+  if (!params || !template_params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  *out_speed = params_typed->fallback_speed;
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  auto* template_typed = reinterpret_cast<osrm::TripParameters*>(template_params);
+  osrmc_apply_template_helper(*params_typed, *template_typed);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_set_fallback_coordinate_type(osrmc_table_params_t params,
-                                                table_coordinate_type_t coord_type,
-                                                osrmc_error_t* error) try {
+osrmc_trip_params_set_roundtrip(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  switch (coord_type) {
-    case TABLE_COORDINATE_INPUT:
-      params_typed->fallback_coordinate_type = osrm::TableParameters::FallbackCoordinateType::Input;
-      break;
-    case TABLE_COORDINATE_SNAPPED:
-      params_typed->fallback_coordinate_type = osrm::TableParameters::FallbackCoordinateType::Snapped;
-      break;
-    default:
-      osrmc_set_error(error, "InvalidArgument", "Unknown table coordinate type");
-      return;
-  }
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  params_typed->roundtrip = (on != 0);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_get_fallback_coordinate_type(osrmc_table_params_t params,
-                                                table_coordinate_type_t* out_coord_type,
-                                                osrmc_error_t* error) try {
-  if (!out_coord_type) {
+osrmc_trip_params_get_roundtrip(osrmc_trip_params_t params, int* out_on, osrmc_error_t* error) try {
+  if (!out_on) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -2027,38 +7149,27 @@ osrmc_table_params_get_fallback_coordinate_type(osrmc_table_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  switch (params_typed->fallback_coordinate_type) {
-    case osrm::TableParameters::FallbackCoordinateType::Input:
-      *out_coord_type = TABLE_COORDINATE_INPUT;
-      break;
-    case osrm::TableParameters::FallbackCoordinateType::Snapped:
-      *out_coord_type = TABLE_COORDINATE_SNAPPED;
-      break;
-  }
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  *out_on = params_typed->roundtrip ? 1 : 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_set_scale_factor(osrmc_table_params_t params, double scale_factor, osrmc_error_t* error) try {
+osrmc_trip_params_set_source(osrmc_trip_params_t params, trip_source_type_t source, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  if (scale_factor <= 0) {
-    osrmc_set_error(error, "InvalidArgument", "Scale factor must be positive");
-    return;
-  }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  params_typed->scale_factor = scale_factor;
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  params_typed->source = static_cast<osrm::TripParameters::SourceType>(source);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_params_get_scale_factor(osrmc_table_params_t params, double* out_scale_factor, osrmc_error_t* error) try {
-  if (!out_scale_factor) {
+osrmc_trip_params_get_source(osrmc_trip_params_t params, trip_source_type_t* out_source, osrmc_error_t* error) try {
+  if (!out_source) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -2066,95 +7177,58 @@ osrmc_table_params_get_scale_factor(osrmc_table_params_t params, double* out_sca
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TableParameters*>(params);
-  *out_scale_factor = params_typed->scale_factor;
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  *out_source = static_cast<trip_source_type_t>(params_typed->source);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-osrmc_table_response_t
-osrmc_table(osrmc_osrm_t osrm, osrmc_table_params_t params, osrmc_error_t* error) {
-  return osrmc_service_helper<osrmc_table_params_t, osrm::TableParameters, osrmc_table_response_t>(
-    osrm,
-    params,
-    [](osrm::OSRM& o, osrm::TableParameters& p, osrm::engine::api::ResultT& r) { return o.Table(p, r); },
-    "TableError",
-    error);
-}
-
 void
-osrmc_table_response_destruct(osrmc_table_response_t response) {
-  if (response) {
-    delete reinterpret_cast<osrmc_response*>(response);
+osrmc_trip_params_set_destination(osrmc_trip_params_t params,
+                                  trip_destination_type_t destination,
+                                  osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
   }
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  params_typed->destination = static_cast<osrm::TripParameters::DestinationType>(destination);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_table_response_transfer_flatbuffer(osrmc_table_response_t response,
-                                         uint8_t** data,
-                                         size_t* size,
-                                         void (**deleter)(void*),
-                                         osrmc_error_t* error) try {
-  if (!response) {
-    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
-    if (data)
-      *data = nullptr;
-    if (size)
-      *size = 0;
-    if (deleter)
-      *deleter = nullptr;
+osrmc_trip_params_get_destination(osrmc_trip_params_t params,
+                                  trip_destination_type_t* out_destination,
+                                  osrmc_error_t* error) try {
+  if (!out_destination) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!data || !size || !deleter) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* resp = reinterpret_cast<osrmc_response*>(response);
-  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-  if (data)
-    *data = nullptr;
-  if (size)
-    *size = 0;
-  if (deleter)
-    *deleter = nullptr;
-}
-
-/* Match */
-
-osrmc_match_params_t
-osrmc_match_params_construct(osrmc_error_t* error) try {
-  auto* out = new osrm::MatchParameters;
-  // Always set FlatBuffer format
-  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
-  return reinterpret_cast<osrmc_match_params_t>(out);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  *out_destination = static_cast<trip_destination_type_t>(params_typed->destination);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  return nullptr;
-}
-
-void
-osrmc_match_params_destruct(osrmc_match_params_t params) {
-  if (params) {
-    delete reinterpret_cast<osrm::MatchParameters*>(params);
-  }
 }
 
 void
-osrmc_match_params_set_steps(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
+osrmc_trip_params_set_steps(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   params_typed->steps = on != 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_get_steps(osrmc_match_params_t params, int* out_on, osrmc_error_t* error) try {
+osrmc_trip_params_get_steps(osrmc_trip_params_t params, int* out_on, osrmc_error_t* error) try {
   if (!out_on) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -2163,26 +7237,26 @@ osrmc_match_params_get_steps(osrmc_match_params_t params, int* out_on, osrmc_err
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   *out_on = params_typed->steps ? 1 : 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_set_alternatives(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
+osrmc_trip_params_set_alternatives(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   params_typed->alternatives = on != 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_get_alternatives(osrmc_match_params_t params, int* out_on, osrmc_error_t* error) try {
+osrmc_trip_params_get_alternatives(osrmc_trip_params_t params, int* out_on, osrmc_error_t* error) try {
   if (!out_on) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -2191,19 +7265,19 @@ osrmc_match_params_get_alternatives(osrmc_match_params_t params, int* out_on, os
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   *out_on = params_typed->alternatives ? 1 : 0;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_set_geometries(osrmc_match_params_t params, geometries_type_t geometries, osrmc_error_t* error) try {
+osrmc_trip_params_set_geometries(osrmc_trip_params_t params, geometries_type_t geometries, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   switch (geometries) {
     case GEOMETRIES_POLYLINE:
       params_typed->geometries = osrm::RouteParameters::GeometriesType::Polyline;
@@ -2223,9 +7297,9 @@ osrmc_match_params_set_geometries(osrmc_match_params_t params, geometries_type_t
 }
 
 void
-osrmc_match_params_get_geometries(osrmc_match_params_t params,
-                                  geometries_type_t* out_geometries,
-                                  osrmc_error_t* error) try {
+osrmc_trip_params_get_geometries(osrmc_trip_params_t params,
+                                 geometries_type_t* out_geometries,
+                                 osrmc_error_t* error) try {
   if (!out_geometries) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -2234,7 +7308,7 @@ osrmc_match_params_get_geometries(osrmc_match_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   switch (params_typed->geometries) {
     case osrm::RouteParameters::GeometriesType::Polyline:
       *out_geometries = GEOMETRIES_POLYLINE;
@@ -2251,12 +7325,12 @@ osrmc_match_params_get_geometries(osrmc_match_params_t params,
 }
 
 void
-osrmc_match_params_set_overview(osrmc_match_params_t params, overview_type_t overview, osrmc_error_t* error) try {
+osrmc_trip_params_set_overview(osrmc_trip_params_t params, overview_type_t overview, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   switch (overview) {
     case OVERVIEW_SIMPLIFIED:
       params_typed->overview = osrm::RouteParameters::OverviewType::Simplified;
@@ -2276,7 +7350,7 @@ osrmc_match_params_set_overview(osrmc_match_params_t params, overview_type_t ove
 }
 
 void
-osrmc_match_params_get_overview(osrmc_match_params_t params, overview_type_t* out_overview, osrmc_error_t* error) try {
+osrmc_trip_params_get_overview(osrmc_trip_params_t params, overview_type_t* out_overview, osrmc_error_t* error) try {
   if (!out_overview) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -2285,7 +7359,7 @@ osrmc_match_params_get_overview(osrmc_match_params_t params, overview_type_t* ou
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   switch (params_typed->overview) {
     case osrm::RouteParameters::OverviewType::Simplified:
       *out_overview = OVERVIEW_SIMPLIFIED;
@@ -2302,12 +7376,12 @@ osrmc_match_params_get_overview(osrmc_match_params_t params, overview_type_t* ou
 }
 
 void
-osrmc_match_params_set_continue_straight(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
+osrmc_trip_params_set_continue_straight(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   if (on < 0) {
     params_typed->continue_straight = std::nullopt;
   } else {
@@ -2318,10 +7392,10 @@ osrmc_match_params_set_continue_straight(osrmc_match_params_t params, int on, os
 }
 
 void
-osrmc_match_params_get_continue_straight(osrmc_match_params_t params,
-                                         int* out_on,
-                                         int* out_is_set,
-                                         osrmc_error_t* error) try {
+osrmc_trip_params_get_continue_straight(osrmc_trip_params_t params,
+                                        int* out_on,
+                                        int* out_is_set,
+                                        osrmc_error_t* error) try {
   if (!out_on || !out_is_set) {
     osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
@@ -2330,7 +7404,7 @@ osrmc_match_params_get_continue_straight(osrmc_match_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   if (!params_typed->continue_straight) {
     *out_is_set = 0;
     return;
@@ -2342,12 +7416,12 @@ osrmc_match_params_get_continue_straight(osrmc_match_params_t params,
 }
 
 void
-osrmc_match_params_set_number_of_alternatives(osrmc_match_params_t params, unsigned count, osrmc_error_t* error) try {
+osrmc_trip_params_set_number_of_alternatives(osrmc_trip_params_t params, unsigned count, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   params_typed->number_of_alternatives = count;
   params_typed->alternatives = count > 0;
 } catch (const std::exception& e) {
@@ -2355,9 +7429,9 @@ osrmc_match_params_set_number_of_alternatives(osrmc_match_params_t params, unsig
 }
 
 void
-osrmc_match_params_get_number_of_alternatives(osrmc_match_params_t params,
-                                              unsigned* out_count,
-                                              osrmc_error_t* error) try {
+osrmc_trip_params_get_number_of_alternatives(osrmc_trip_params_t params,
+                                             unsigned* out_count,
+                                             osrmc_error_t* error) try {
   if (!out_count) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -2366,21 +7440,21 @@ osrmc_match_params_get_number_of_alternatives(osrmc_match_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   *out_count = params_typed->number_of_alternatives;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_set_annotations(osrmc_match_params_t params,
-                                   annotations_type_t annotations,
-                                   osrmc_error_t* error) try {
+osrmc_trip_params_set_annotations(osrmc_trip_params_t params,
+                                  annotations_type_t annotations,
+                                  osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   params_typed->annotations_type = static_cast<osrm::RouteParameters::AnnotationsType>(annotations);
   params_typed->annotations = (annotations != ANNOTATIONS_NONE);
 } catch (const std::exception& e) {
@@ -2388,9 +7462,9 @@ osrmc_match_params_set_annotations(osrmc_match_params_t params,
 }
 
 void
-osrmc_match_params_get_annotations(osrmc_match_params_t params,
-                                   annotations_type_t* out_annotations,
-                                   osrmc_error_t* error) try {
+osrmc_trip_params_get_annotations(osrmc_trip_params_t params,
+                                  annotations_type_t* out_annotations,
+                                  osrmc_error_t* error) try {
   if (!out_annotations) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
@@ -2399,109 +7473,239 @@ osrmc_match_params_get_annotations(osrmc_match_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   *out_annotations = static_cast<annotations_type_t>(params_typed->annotations_type);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_add_waypoint(osrmc_match_params_t params, size_t index, osrmc_error_t* error) try {
+osrmc_trip_params_clear_waypoints(osrmc_trip_params_t params, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  params_typed->waypoints.clear();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_trip_params_add_waypoint(osrmc_trip_params_t params, size_t index, osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
   params_typed->waypoints.emplace_back(index);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_get_waypoint_count(osrmc_match_params_t params, size_t* out_count, osrmc_error_t* error) try {
+osrmc_trip_params_get_waypoint_count(osrmc_trip_params_t params, size_t* out_count, osrmc_error_t* error) try {
   if (!out_count) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  *out_count = params_typed->waypoints.size();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_trip_params_get_waypoint(osrmc_trip_params_t params, size_t index, size_t* out_index, osrmc_error_t* error) try {
+  if (!out_index) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  if (index >= params_typed->waypoints.size()) {
+    osrmc_set_error(error, "InvalidIndex", "Waypoint index out of bounds");
+    return;
+  }
+  *out_index = params_typed->waypoints[index];
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+void
+osrmc_trip_params_set_waypoints(osrmc_trip_params_t params,
+                                const size_t* indices,
+                                size_t count,
+                                osrmc_error_t* error) try {
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return;
+  }
+  if (count > 0 && !indices) {
+    osrmc_set_error(error, "InvalidArgument", "Input pointer must not be null");
+    return;
+  }
+  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
+  params_typed->waypoints.assign(indices, indices + count);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+osrmc_trip_response_t
+osrmc_trip(osrmc_osrm_t osrm, osrmc_trip_params_t params, osrmc_error_t* error) {
+  return osrmc_service_helper<osrmc_trip_params_t, osrm::TripParameters, osrmc_trip_response_t>(
+    osrm,
+    params,
+    SERVICE_TRIP,
+    [](osrm::OSRM& o, osrm::TripParameters& p, osrm::engine::api::ResultT& r) { return o.Trip(p, r); },
+    "TripError",
+    error);
+}
+
+void
+osrmc_trip_response_destruct(osrmc_trip_response_t response) {
+  if (response) {
+    osrmc_response_destruct_helper(reinterpret_cast<osrmc_response*>(response));
+  }
+}
+
+void
+osrmc_trip_batch(osrmc_osrm_t osrm,
+                 const osrmc_trip_params_t* params,
+                 size_t n,
+                 osrmc_trip_response_t* out,
+                 osrmc_error_t* errors) {
+  osrmc_batch_helper(osrm, params, n, out, errors, SERVICE_TRIP, osrmc_trip);
+}
+
+void
+osrmc_trip_response_transfer_flatbuffer(osrmc_trip_response_t response,
+                                        uint8_t** data,
+                                        size_t* size,
+                                        void (**deleter)(void*),
+                                        osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    if (data)
+      *data = nullptr;
+    if (size)
+      *size = 0;
+    if (deleter)
+      *deleter = nullptr;
+    return;
+  }
+  if (!data || !size || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  *out_count = params_typed->waypoints.size();
+  auto* resp = reinterpret_cast<osrmc_response*>(response);
+  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  if (data)
+    *data = nullptr;
+  if (size)
+    *size = 0;
+  if (deleter)
+    *deleter = nullptr;
 }
 
 void
-osrmc_match_params_get_waypoint(osrmc_match_params_t params,
-                                size_t index,
-                                size_t* out_index,
-                                osrmc_error_t* error) try {
-  if (!out_index) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
-  }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+osrmc_trip_response_detach_flatbuffer(osrmc_trip_response_t response,
+                                      uint8_t** data,
+                                      size_t* size,
+                                      void** owner,
+                                      void (**deleter)(void*),
+                                      osrmc_error_t* error) try {
+  if (!data || !size || !owner || !deleter) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  if (index >= params_typed->waypoints.size()) {
-    osrmc_set_error(error, "InvalidIndex", "Waypoint index out of bounds");
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    *data = nullptr;
+    *size = 0;
+    *owner = nullptr;
+    *deleter = nullptr;
     return;
   }
-  *out_index = params_typed->waypoints[index];
+  osrmc_detach_flatbuffer_helper(reinterpret_cast<osrmc_response*>(response), data, size, owner, deleter, error);
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+}
+
+/* Tile */
+
+osrmc_tile_params_t
+osrmc_tile_params_construct(osrmc_error_t* error) try {
+  auto* out = osrmc_new_params<osrm::TileParameters>();
+  out->x = 0;
+  out->y = 0;
+  out->z = 0;
+  return reinterpret_cast<osrmc_tile_params_t>(out);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
 void
-osrmc_match_params_clear_waypoints(osrmc_match_params_t params, osrmc_error_t* error) try {
+osrmc_tile_params_destruct(osrmc_tile_params_t params) {
+  if (params) {
+    osrmc_delete_params(reinterpret_cast<osrm::TileParameters*>(params));
+  }
+}
+
+void
+osrmc_tile_params_reset(osrmc_tile_params_t params, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  params_typed->waypoints.clear();
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  params_typed->x = 0;
+  params_typed->y = 0;
+  params_typed->z = 0;
+  osrmc_erase_controls(params);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_match_params_add_timestamp(osrmc_match_params_t params, unsigned timestamp, osrmc_error_t* error) try {
+osrmc_tile_params_t
+osrmc_tile_params_clone(osrmc_tile_params_t params, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+    return nullptr;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  params_typed->timestamps.emplace_back(timestamp);
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  auto* out = osrmc_new_params<osrm::TileParameters>(*params_typed);
+  return reinterpret_cast<osrmc_tile_params_t>(out);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
 void
-osrmc_match_params_get_timestamp_count(osrmc_match_params_t params, size_t* out_count, osrmc_error_t* error) try {
-  if (!out_count) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
-  }
+osrmc_tile_params_set_x(osrmc_tile_params_t params, unsigned x, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  *out_count = params_typed->timestamps.size();
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  params_typed->x = x;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_get_timestamp(osrmc_match_params_t params,
-                                 size_t index,
-                                 unsigned* out_timestamp,
-                                 osrmc_error_t* error) try {
-  if (!out_timestamp) {
+osrmc_tile_params_get_x(osrmc_tile_params_t params, unsigned* out_x, osrmc_error_t* error) try {
+  if (!out_x) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -2509,31 +7713,27 @@ osrmc_match_params_get_timestamp(osrmc_match_params_t params,
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  if (index >= params_typed->timestamps.size()) {
-    osrmc_set_error(error, "InvalidIndex", "Timestamp index out of bounds");
-    return;
-  }
-  *out_timestamp = params_typed->timestamps[index];
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  *out_x = params_typed->x;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_set_gaps(osrmc_match_params_t params, match_gaps_type_t gaps, osrmc_error_t* error) try {
+osrmc_tile_params_set_y(osrmc_tile_params_t params, unsigned y, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  params_typed->gaps = static_cast<osrm::MatchParameters::GapsType>(gaps);
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  params_typed->y = y;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_get_gaps(osrmc_match_params_t params, match_gaps_type_t* out_gaps, osrmc_error_t* error) try {
-  if (!out_gaps) {
+osrmc_tile_params_get_y(osrmc_tile_params_t params, unsigned* out_y, osrmc_error_t* error) try {
+  if (!out_y) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -2541,27 +7741,27 @@ osrmc_match_params_get_gaps(osrmc_match_params_t params, match_gaps_type_t* out_
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  *out_gaps = static_cast<match_gaps_type_t>(params_typed->gaps);
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  *out_y = params_typed->y;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_set_tidy(osrmc_match_params_t params, int on, osrmc_error_t* error) try {
+osrmc_tile_params_set_z(osrmc_tile_params_t params, unsigned z, osrmc_error_t* error) try {
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  params_typed->tidy = on != 0;
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  params_typed->z = z;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_match_params_get_tidy(osrmc_match_params_t params, int* out_on, osrmc_error_t* error) try {
-  if (!out_on) {
+osrmc_tile_params_get_z(osrmc_tile_params_t params, unsigned* out_z, osrmc_error_t* error) try {
+  if (!out_z) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
@@ -2569,729 +7769,1777 @@ osrmc_match_params_get_tidy(osrmc_match_params_t params, int* out_on, osrmc_erro
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::MatchParameters*>(params);
-  *out_on = params_typed->tidy ? 1 : 0;
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+  *out_z = params_typed->z;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-osrmc_match_response_t
-osrmc_match(osrmc_osrm_t osrm, osrmc_match_params_t params, osrmc_error_t* error) {
-  return osrmc_service_helper<osrmc_match_params_t, osrm::MatchParameters, osrmc_match_response_t>(
+osrmc_tile_response_t
+osrmc_tile(osrmc_osrm_t osrm, osrmc_tile_params_t params, osrmc_error_t* error) try {
+  const bool granted = std::exchange(osrmc_slot_granted, false);
+  if (!osrm) {
+    osrmc_set_error(error, "InvalidArgument", "OSRM instance must not be null");
+    return nullptr;
+  }
+  if (!params) {
+    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+    return nullptr;
+  }
+  if (!osrmc_check_controls(params, error)) {
+    return nullptr;
+  }
+  auto* osrm_typed = &osrm->engine;
+  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
+
+  // Tile returns binary data as std::string (not JSON Object)
+  osrm::engine::api::ResultT result = std::string();
+  const auto outcome = osrmc_execute_request(
     osrm,
-    params,
-    [](osrm::OSRM& o, osrm::MatchParameters& p, osrm::engine::api::ResultT& r) { return o.Match(p, r); },
-    "MatchError",
+    SERVICE_TILE,
+    *params_typed,
+    granted,
+    [&](osrm::engine::api::ResultT& out) { return osrm_typed->Tile(*params_typed, out); },
+    result,
     error);
+  if (!outcome) {
+    return nullptr;
+  }
+  const auto status = *outcome;
+
+  if (!osrmc_check_controls(params, error)) {
+    return nullptr;
+  }
+  if (status == osrm::Status::Ok) {
+    auto* out = new std::string(std::move(std::get<std::string>(result)));
+    return reinterpret_cast<osrmc_tile_response_t>(out);
+  }
+
+  if (std::holds_alternative<osrm::json::Object>(result)) {
+    auto& json = std::get<osrm::json::Object>(result);
+    if (error) {
+      auto code = std::get<osrm::json::String>(json.values["code"]).value;
+      auto message = std::get<osrm::json::String>(json.values["message"]).value;
+      if (code.empty()) {
+        code = "Unknown";
+      }
+      osrmc_set_error(error, code.c_str(), message.c_str());
+    }
+  } else {
+    osrmc_set_error(error, "TileError", "Failed to generate tile");
+  }
+
+  return nullptr;
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
 void
-osrmc_match_response_destruct(osrmc_match_response_t response) {
+osrmc_tile_response_destruct(osrmc_tile_response_t response) {
   if (response) {
-    delete reinterpret_cast<osrmc_response*>(response);
+    delete reinterpret_cast<std::string*>(response);
   }
 }
 
 void
-osrmc_match_response_transfer_flatbuffer(osrmc_match_response_t response,
-                                         uint8_t** data,
-                                         size_t* size,
-                                         void (**deleter)(void*),
-                                         osrmc_error_t* error) try {
+osrmc_tile_batch(osrmc_osrm_t osrm,
+                 const osrmc_tile_params_t* params,
+                 size_t n,
+                 osrmc_tile_response_t* out,
+                 osrmc_error_t* errors) {
+  osrmc_batch_helper(osrm, params, n, out, errors, SERVICE_TILE, osrmc_tile);
+}
+
+size_t
+osrmc_tile_response_size(osrmc_tile_response_t response, osrmc_error_t* error) try {
   if (!response) {
     osrmc_set_error(error, "InvalidArgument", "Response must not be null");
-    if (data)
-      *data = nullptr;
-    if (size)
+    return 0;
+  }
+  auto* response_typed = reinterpret_cast<std::string*>(response);
+  return response_typed->size();
+} catch (const std::exception& e) {
+  osrmc_error_from_exception(e, error);
+  return 0;
+}
+
+const char*
+osrmc_tile_response_data(osrmc_tile_response_t response, size_t* size, osrmc_error_t* error) try {
+  if (!response) {
+    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
+    if (size) {
       *size = 0;
-    if (deleter)
-      *deleter = nullptr;
-    return;
+    }
+    return nullptr;
   }
-  if (!data || !size || !deleter) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
-    return;
+  auto* response_typed = reinterpret_cast<std::string*>(response);
+
+  if (size) {
+    *size = response_typed->size();
   }
-  auto* resp = reinterpret_cast<osrmc_response*>(response);
-  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
+
+  return response_typed->data();
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  if (data)
-    *data = nullptr;
-  if (size)
+  if (size) {
     *size = 0;
-  if (deleter)
-    *deleter = nullptr;
+  }
+  return nullptr;
 }
 
-/* Trip */
+/* Binary requests */
+
+// Service union type values of osrmc_request.fbs
+enum osrmc_request_service : std::uint8_t {
+  OSRMC_REQUEST_NEAREST = 1,
+  OSRMC_REQUEST_ROUTE = 2,
+  OSRMC_REQUEST_TABLE = 3,
+  OSRMC_REQUEST_MATCH = 4,
+  OSRMC_REQUEST_TRIP = 5,
+  OSRMC_REQUEST_TILE = 6
+};
+
+// Field ids of the tables of osrmc_request.fbs; `make check-schema` checks them against the flatc output
+enum osrmc_request_field : flatbuffers::voffset_t {
+  OSRMC_REQUEST_SERVICE_TYPE = 0,
+  OSRMC_REQUEST_SERVICE = 1,
+};
+
+enum osrmc_base_field : flatbuffers::voffset_t {
+  OSRMC_BASE_LONGITUDES = 0,
+  OSRMC_BASE_LATITUDES = 1,
+  OSRMC_BASE_HINTS = 2,
+  OSRMC_BASE_RADIUSES = 3,
+  OSRMC_BASE_BEARING_VALUES = 4,
+  OSRMC_BASE_BEARING_RANGES = 5,
+  OSRMC_BASE_APPROACHES = 6,
+  OSRMC_BASE_EXCLUDE = 7,
+  OSRMC_BASE_GENERATE_HINTS = 8,
+  OSRMC_BASE_SKIP_WAYPOINTS = 9,
+  OSRMC_BASE_SNAPPING = 10
+};
+
+enum osrmc_route_options_field : flatbuffers::voffset_t {
+  OSRMC_ROUTE_OPTIONS_STEPS = 0,
+  OSRMC_ROUTE_OPTIONS_ALTERNATIVES = 1,
+  OSRMC_ROUTE_OPTIONS_NUMBER_OF_ALTERNATIVES = 2,
+  OSRMC_ROUTE_OPTIONS_ANNOTATIONS = 3,
+  OSRMC_ROUTE_OPTIONS_GEOMETRIES = 4,
+  OSRMC_ROUTE_OPTIONS_OVERVIEW = 5,
+  OSRMC_ROUTE_OPTIONS_CONTINUE_STRAIGHT = 6,
+  OSRMC_ROUTE_OPTIONS_WAYPOINTS = 7
+};
+
+// Every service table starts with its base table; route-like services follow with their route options
+enum osrmc_service_field : flatbuffers::voffset_t {
+  OSRMC_SERVICE_BASE = 0,
+  OSRMC_SERVICE_ROUTE = 1,
+  OSRMC_NEAREST_NUMBER_OF_RESULTS = 1,
+  OSRMC_TABLE_SOURCES = 1,
+  OSRMC_TABLE_DESTINATIONS = 2,
+  OSRMC_TABLE_ANNOTATIONS = 3,
+  OSRMC_TABLE_FALLBACK_SPEED = 4,
+  OSRMC_TABLE_FALLBACK_COORDINATE_TYPE = 5,
+  OSRMC_TABLE_SCALE_FACTOR = 6,
+  OSRMC_MATCH_TIMESTAMPS = 2,
+  OSRMC_MATCH_GAPS = 3,
+  OSRMC_MATCH_TIDY = 4,
+  OSRMC_TRIP_ROUNDTRIP = 2,
+  OSRMC_TRIP_SOURCE = 3,
+  OSRMC_TRIP_DESTINATION = 4,
+  OSRMC_TILE_X = 0,
+  OSRMC_TILE_Y = 1,
+  OSRMC_TILE_Z = 2
+};
+
+// vtable slot of the field with schema id `id`, as computed by flatc
+static constexpr flatbuffers::voffset_t
+osrmc_request_slot(flatbuffers::voffset_t id) {
+  return static_cast<flatbuffers::voffset_t>(4 + 2 * id);
+}
+
+#if defined(OSRMC_CHECK_REQUEST_SCHEMA)
+// Built by `make check-schema` against the header flatc generates from osrmc_request.fbs
+#include "osrmc_request_generated.h"
+
+namespace osrmc_request_schema = osrmc::request;
+#define OSRMC_CHECK_SERVICE(service, value) \
+  static_assert(static_cast<int>(value) == static_cast<int>(osrmc_request_schema::Service_##service), #service)
+OSRMC_CHECK_SERVICE(Nearest, OSRMC_REQUEST_NEAREST);
+OSRMC_CHECK_SERVICE(Route, OSRMC_REQUEST_ROUTE);
+OSRMC_CHECK_SERVICE(Table, OSRMC_REQUEST_TABLE);
+OSRMC_CHECK_SERVICE(Match, OSRMC_REQUEST_MATCH);
+OSRMC_CHECK_SERVICE(Trip, OSRMC_REQUEST_TRIP);
+OSRMC_CHECK_SERVICE(Tile, OSRMC_REQUEST_TILE);
+#undef OSRMC_CHECK_SERVICE
+#define OSRMC_CHECK_FIELD(table, field, id) \
+  static_assert(osrmc_request_slot(id) == osrmc_request_schema::table::VT_##field, #table "." #field)
+OSRMC_CHECK_FIELD(Request, SERVICE_TYPE, OSRMC_REQUEST_SERVICE_TYPE);
+OSRMC_CHECK_FIELD(Request, SERVICE, OSRMC_REQUEST_SERVICE);
+OSRMC_CHECK_FIELD(Base, LONGITUDES, OSRMC_BASE_LONGITUDES);
+OSRMC_CHECK_FIELD(Base, LATITUDES, OSRMC_BASE_LATITUDES);
+OSRMC_CHECK_FIELD(Base, HINTS, OSRMC_BASE_HINTS);
+OSRMC_CHECK_FIELD(Base, RADIUSES, OSRMC_BASE_RADIUSES);
+OSRMC_CHECK_FIELD(Base, BEARING_VALUES, OSRMC_BASE_BEARING_VALUES);
+OSRMC_CHECK_FIELD(Base, BEARING_RANGES, OSRMC_BASE_BEARING_RANGES);
+OSRMC_CHECK_FIELD(Base, APPROACHES, OSRMC_BASE_APPROACHES);
+OSRMC_CHECK_FIELD(Base, EXCLUDE, OSRMC_BASE_EXCLUDE);
+OSRMC_CHECK_FIELD(Base, GENERATE_HINTS, OSRMC_BASE_GENERATE_HINTS);
+OSRMC_CHECK_FIELD(Base, SKIP_WAYPOINTS, OSRMC_BASE_SKIP_WAYPOINTS);
+OSRMC_CHECK_FIELD(Base, SNAPPING, OSRMC_BASE_SNAPPING);
+OSRMC_CHECK_FIELD(RouteOptions, STEPS, OSRMC_ROUTE_OPTIONS_STEPS);
+OSRMC_CHECK_FIELD(RouteOptions, ALTERNATIVES, OSRMC_ROUTE_OPTIONS_ALTERNATIVES);
+OSRMC_CHECK_FIELD(RouteOptions, NUMBER_OF_ALTERNATIVES, OSRMC_ROUTE_OPTIONS_NUMBER_OF_ALTERNATIVES);
+OSRMC_CHECK_FIELD(RouteOptions, ANNOTATIONS, OSRMC_ROUTE_OPTIONS_ANNOTATIONS);
+OSRMC_CHECK_FIELD(RouteOptions, GEOMETRIES, OSRMC_ROUTE_OPTIONS_GEOMETRIES);
+OSRMC_CHECK_FIELD(RouteOptions, OVERVIEW, OSRMC_ROUTE_OPTIONS_OVERVIEW);
+OSRMC_CHECK_FIELD(RouteOptions, CONTINUE_STRAIGHT, OSRMC_ROUTE_OPTIONS_CONTINUE_STRAIGHT);
+OSRMC_CHECK_FIELD(RouteOptions, WAYPOINTS, OSRMC_ROUTE_OPTIONS_WAYPOINTS);
+OSRMC_CHECK_FIELD(Nearest, BASE, OSRMC_SERVICE_BASE);
+OSRMC_CHECK_FIELD(Nearest, NUMBER_OF_RESULTS, OSRMC_NEAREST_NUMBER_OF_RESULTS);
+OSRMC_CHECK_FIELD(Route, BASE, OSRMC_SERVICE_BASE);
+OSRMC_CHECK_FIELD(Route, ROUTE, OSRMC_SERVICE_ROUTE);
+OSRMC_CHECK_FIELD(Table, BASE, OSRMC_SERVICE_BASE);
+OSRMC_CHECK_FIELD(Table, SOURCES, OSRMC_TABLE_SOURCES);
+OSRMC_CHECK_FIELD(Table, DESTINATIONS, OSRMC_TABLE_DESTINATIONS);
+OSRMC_CHECK_FIELD(Table, ANNOTATIONS, OSRMC_TABLE_ANNOTATIONS);
+OSRMC_CHECK_FIELD(Table, FALLBACK_SPEED, OSRMC_TABLE_FALLBACK_SPEED);
+OSRMC_CHECK_FIELD(Table, FALLBACK_COORDINATE_TYPE, OSRMC_TABLE_FALLBACK_COORDINATE_TYPE);
+OSRMC_CHECK_FIELD(Table, SCALE_FACTOR, OSRMC_TABLE_SCALE_FACTOR);
+OSRMC_CHECK_FIELD(Match, BASE, OSRMC_SERVICE_BASE);
+OSRMC_CHECK_FIELD(Match, ROUTE, OSRMC_SERVICE_ROUTE);
+OSRMC_CHECK_FIELD(Match, TIMESTAMPS, OSRMC_MATCH_TIMESTAMPS);
+OSRMC_CHECK_FIELD(Match, GAPS, OSRMC_MATCH_GAPS);
+OSRMC_CHECK_FIELD(Match, TIDY, OSRMC_MATCH_TIDY);
+OSRMC_CHECK_FIELD(Trip, BASE, OSRMC_SERVICE_BASE);
+OSRMC_CHECK_FIELD(Trip, ROUTE, OSRMC_SERVICE_ROUTE);
+OSRMC_CHECK_FIELD(Trip, ROUNDTRIP, OSRMC_TRIP_ROUNDTRIP);
+OSRMC_CHECK_FIELD(Trip, SOURCE, OSRMC_TRIP_SOURCE);
+OSRMC_CHECK_FIELD(Trip, DESTINATION, OSRMC_TRIP_DESTINATION);
+OSRMC_CHECK_FIELD(Tile, X, OSRMC_TILE_X);
+OSRMC_CHECK_FIELD(Tile, Y, OSRMC_TILE_Y);
+OSRMC_CHECK_FIELD(Tile, Z, OSRMC_TILE_Z);
+#undef OSRMC_CHECK_FIELD
+#endif
+
+struct osrmc_request_context final {
+  osrmc_request_context(const uint8_t* data, size_t size) : verifier(data, size) {}
+
+  flatbuffers::Verifier verifier;
+  bool ok = true;
+};
+
+// Field access for tables of osrmc_request.fbs. Every field is verified before it is read, so truncated or
+// malformed buffers never cause out of bounds reads; a failed verification latches into the shared context.
+class osrmc_request_reader final {
+public:
+  osrmc_request_reader(osrmc_request_context& context, const flatbuffers::Table* table)
+    : context_(context), table_(table) {
+    if (table_ && !table_->VerifyTableStart(context_.verifier)) {
+      context_.ok = false;
+      table_ = nullptr;
+    }
+  }
+
+  // Closes the table opened by VerifyTableStart, so nesting depth is tracked like in generated verifiers
+  ~osrmc_request_reader() {
+    if (table_) {
+      context_.verifier.EndTable();
+    }
+  }
+
+  osrmc_request_reader(const osrmc_request_reader&) = delete;
+  osrmc_request_reader&
+  operator=(const osrmc_request_reader&) = delete;
+
+  explicit operator bool() const {
+    return table_ != nullptr;
+  }
+
+  template<typename T>
+  std::optional<T> scalar(flatbuffers::voffset_t id) const {
+    const auto field = osrmc_request_slot(id);
+    if (!table_ || !table_->CheckField(field)) {
+      return std::nullopt;
+    }
+    if (!table_->VerifyField<T>(context_.verifier, field, sizeof(T))) {
+      context_.ok = false;
+      return std::nullopt;
+    }
+    return table_->GetField<T>(field, T());
+  }
+
+  std::optional<bool> flag(flatbuffers::voffset_t id) const {
+    const auto value = scalar<std::uint8_t>(id);
+    return value ? std::optional<bool>(*value != 0) : std::nullopt;
+  }
+
+  template<typename T>
+  const flatbuffers::Vector<T>* vector(flatbuffers::voffset_t id) const {
+    const auto* values = pointer<const flatbuffers::Vector<T>*>(id);
+    if (values && !context_.verifier.VerifyVector(values)) {
+      context_.ok = false;
+      return nullptr;
+    }
+    return values;
+  }
+
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>* strings(flatbuffers::voffset_t id) const {
+    const auto* values = vector<flatbuffers::Offset<flatbuffers::String>>(id);
+    if (values && !context_.verifier.VerifyVectorOfStrings(values)) {
+      context_.ok = false;
+      return nullptr;
+    }
+    return values;
+  }
 
-osrmc_trip_params_t
-osrmc_trip_params_construct(osrmc_error_t* error) try {
-  auto* out = new osrm::TripParameters;
-  // Always set FlatBuffer format
-  out->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
-  return reinterpret_cast<osrmc_trip_params_t>(out);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-  return nullptr;
-}
+  osrmc_request_reader table(flatbuffers::voffset_t id) const {
+    return osrmc_request_reader(context_, pointer<const flatbuffers::Table*>(id));
+  }
 
-void
-osrmc_trip_params_destruct(osrmc_trip_params_t params) {
-  if (params) {
-    delete reinterpret_cast<osrm::TripParameters*>(params);
+private:
+  template<typename P>
+  P pointer(flatbuffers::voffset_t id) const {
+    const auto field = osrmc_request_slot(id);
+    if (!table_ || !table_->CheckField(field)) {
+      return nullptr;
+    }
+    if (!table_->VerifyOffset(context_.verifier, field)) {
+      context_.ok = false;
+      return nullptr;
+    }
+    return table_->GetPointer<P>(field);
   }
-}
 
-void
-osrmc_trip_params_set_roundtrip(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  osrmc_request_context& context_;
+  const flatbuffers::Table* table_;
+};
+
+// Decoders apply the fields of one schema table through the public setters, so buffer input gets the same
+// validation as setter calls. `error` is always non-null and decoding stops at the first failure.
+static void
+osrmc_decode_base(const osrmc_request_reader& base,
+                  osrm::engine::api::BaseParameters& params,
+                  osrmc_error_t* error) {
+  if (!base) {
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->roundtrip = (on != 0);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
+  auto* handle = reinterpret_cast<osrmc_params_t>(&params);
 
-void
-osrmc_trip_params_get_roundtrip(osrmc_trip_params_t params, int* out_on, osrmc_error_t* error) try {
-  if (!out_on) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+  const auto* longitudes = base.vector<double>(OSRMC_BASE_LONGITUDES);
+  const auto* latitudes = base.vector<double>(OSRMC_BASE_LATITUDES);
+  const size_t longitude_count = longitudes ? longitudes->size() : 0;
+  const size_t latitude_count = latitudes ? latitudes->size() : 0;
+  if (longitude_count != latitude_count) {
+    osrmc_set_error(error, "InvalidBuffer", "Longitude and latitude counts differ");
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (longitude_count > 0) {
+    osrmc_params_add_coordinates(handle, longitudes->data(), latitudes->data(), longitude_count, error);
+    if (*error) {
+      return;
+    }
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_on = params_typed->roundtrip ? 1 : 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_trip_params_set_source(osrmc_trip_params_t params, trip_source_type_t source, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (const auto* hints = base.strings(OSRMC_BASE_HINTS); hints && hints->size() > 0) {
+    std::vector<const char*> hints_base64;
+    hints_base64.reserve(hints->size());
+    for (const auto* hint : *hints) {
+      hints_base64.push_back(hint->size() > 0 ? hint->c_str() : nullptr);
+    }
+    osrmc_params_set_hints(handle, hints_base64.data(), hints_base64.size(), error);
+    if (*error) {
+      return;
+    }
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->source = static_cast<osrm::TripParameters::SourceType>(source);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_trip_params_get_source(osrmc_trip_params_t params, trip_source_type_t* out_source, osrmc_error_t* error) try {
-  if (!out_source) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+  if (const auto* radiuses = base.vector<double>(OSRMC_BASE_RADIUSES); radiuses && radiuses->size() > 0) {
+    osrmc_params_set_radiuses(handle, radiuses->data(), radiuses->size(), error);
+    if (*error) {
+      return;
+    }
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+
+  const auto* bearing_values = base.vector<std::int16_t>(OSRMC_BASE_BEARING_VALUES);
+  const auto* bearing_ranges = base.vector<std::int16_t>(OSRMC_BASE_BEARING_RANGES);
+  const size_t bearing_count = bearing_values ? bearing_values->size() : 0;
+  if (bearing_count != (bearing_ranges ? bearing_ranges->size() : 0)) {
+    osrmc_set_error(error, "InvalidBuffer", "Bearing value and range counts differ");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_source = static_cast<trip_source_type_t>(params_typed->source);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
+  if (bearing_count > 0) {
+    const std::vector<int> values(bearing_values->begin(), bearing_values->end());
+    const std::vector<int> ranges(bearing_ranges->begin(), bearing_ranges->end());
+    osrmc_params_set_bearings(handle, values.data(), ranges.data(), bearing_count, error);
+    if (*error) {
+      return;
+    }
+  }
 
-void
-osrmc_trip_params_set_destination(osrmc_trip_params_t params,
-                                  trip_destination_type_t destination,
-                                  osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (const auto* approaches = base.vector<std::int8_t>(OSRMC_BASE_APPROACHES); approaches && approaches->size() > 0) {
+    if (!osrmc_check_coordinate_count(params, approaches->size(), "Approach", error)) {
+      return;
+    }
+    params.approaches.clear();
+    params.approaches.reserve(approaches->size());
+    for (const auto approach : *approaches) {
+      params.approaches.emplace_back(osrmc_to_approach(approach));
+    }
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->destination = static_cast<osrm::TripParameters::DestinationType>(destination);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_trip_params_get_destination(osrmc_trip_params_t params,
-                                  trip_destination_type_t* out_destination,
-                                  osrmc_error_t* error) try {
-  if (!out_destination) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+  if (const auto* exclude = base.strings(OSRMC_BASE_EXCLUDE)) {
+    for (const auto* profile : *exclude) {
+      params.exclude.emplace_back(profile->str());
+    }
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (const auto generate_hints = base.flag(OSRMC_BASE_GENERATE_HINTS)) {
+    params.generate_hints = *generate_hints;
+  }
+  if (const auto skip_waypoints = base.flag(OSRMC_BASE_SKIP_WAYPOINTS)) {
+    params.skip_waypoints = *skip_waypoints;
+  }
+  if (const auto snapping = base.scalar<std::int8_t>(OSRMC_BASE_SNAPPING)) {
+    osrmc_params_set_snapping(handle, static_cast<snapping_t>(*snapping), error);
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_destination = static_cast<trip_destination_type_t>(params_typed->destination);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_trip_params_set_steps(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+static void
+osrmc_decode_route_options(const osrmc_request_reader& route, osrm::RouteParameters& params, osrmc_error_t* error) {
+  if (!route) {
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->steps = on != 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  auto* handle = reinterpret_cast<osrmc_route_params_t>(&params);
+
+  if (const auto steps = route.flag(OSRMC_ROUTE_OPTIONS_STEPS)) {
+    params.steps = *steps;
+  }
+  // number_of_alternatives also toggles alternatives, so an explicit alternatives flag is applied after it
+  if (const auto number_of_alternatives = route.scalar<std::uint32_t>(OSRMC_ROUTE_OPTIONS_NUMBER_OF_ALTERNATIVES)) {
+    params.number_of_alternatives = *number_of_alternatives;
+    params.alternatives = *number_of_alternatives > 0;
+  }
+  if (const auto alternatives = route.flag(OSRMC_ROUTE_OPTIONS_ALTERNATIVES)) {
+    params.alternatives = *alternatives;
+  }
+  if (const auto annotations = route.scalar<std::uint32_t>(OSRMC_ROUTE_OPTIONS_ANNOTATIONS)) {
+    osrmc_route_params_set_annotations(handle, static_cast<annotations_type_t>(*annotations), error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto geometries = route.scalar<std::int8_t>(OSRMC_ROUTE_OPTIONS_GEOMETRIES)) {
+    osrmc_route_params_set_geometries(handle, static_cast<geometries_type_t>(*geometries), error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto overview = route.scalar<std::int8_t>(OSRMC_ROUTE_OPTIONS_OVERVIEW)) {
+    osrmc_route_params_set_overview(handle, static_cast<overview_type_t>(*overview), error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto continue_straight = route.scalar<std::int8_t>(OSRMC_ROUTE_OPTIONS_CONTINUE_STRAIGHT)) {
+    osrmc_route_params_set_continue_straight(handle, *continue_straight, error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto* waypoints = route.vector<std::uint64_t>(OSRMC_ROUTE_OPTIONS_WAYPOINTS)) {
+    params.waypoints.assign(waypoints->begin(), waypoints->end());
+  }
 }
 
-void
-osrmc_trip_params_get_steps(osrmc_trip_params_t params, int* out_on, osrmc_error_t* error) try {
-  if (!out_on) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+static void
+osrmc_decode_nearest(const osrmc_request_reader& nearest, osrm::NearestParameters& params, osrmc_error_t* error) {
+  osrmc_decode_base(nearest.table(OSRMC_SERVICE_BASE), params, error);
+  if (*error) {
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (const auto number_of_results = nearest.scalar<std::uint32_t>(OSRMC_NEAREST_NUMBER_OF_RESULTS)) {
+    params.number_of_results = *number_of_results;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_on = params_typed->steps ? 1 : 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_trip_params_set_alternatives(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+static void
+osrmc_decode_route(const osrmc_request_reader& route, osrm::RouteParameters& params, osrmc_error_t* error) {
+  osrmc_decode_base(route.table(OSRMC_SERVICE_BASE), params, error);
+  if (*error) {
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->alternatives = on != 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  osrmc_decode_route_options(route.table(OSRMC_SERVICE_ROUTE), params, error);
 }
 
-void
-osrmc_trip_params_get_alternatives(osrmc_trip_params_t params, int* out_on, osrmc_error_t* error) try {
-  if (!out_on) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+static void
+osrmc_decode_table(const osrmc_request_reader& table, osrm::TableParameters& params, osrmc_error_t* error) {
+  osrmc_decode_base(table.table(OSRMC_SERVICE_BASE), params, error);
+  if (*error) {
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  auto* handle = reinterpret_cast<osrmc_table_params_t>(&params);
+
+  if (const auto* sources = table.vector<std::uint64_t>(OSRMC_TABLE_SOURCES)) {
+    params.sources.assign(sources->begin(), sources->end());
+  }
+  if (const auto* destinations = table.vector<std::uint64_t>(OSRMC_TABLE_DESTINATIONS)) {
+    params.destinations.assign(destinations->begin(), destinations->end());
+  }
+  if (const auto annotations = table.scalar<std::int8_t>(OSRMC_TABLE_ANNOTATIONS)) {
+    osrmc_table_params_set_annotations(handle, static_cast<table_annotations_type_t>(*annotations), error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto fallback_speed = table.scalar<double>(OSRMC_TABLE_FALLBACK_SPEED);
+      fallback_speed && *fallback_speed != 0) {
+    osrmc_table_params_set_fallback_speed(handle, *fallback_speed, error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto coordinate_type = table.scalar<std::int8_t>(OSRMC_TABLE_FALLBACK_COORDINATE_TYPE)) {
+    osrmc_table_params_set_fallback_coordinate_type(
+      handle, static_cast<table_coordinate_type_t>(*coordinate_type), error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto scale_factor = table.scalar<double>(OSRMC_TABLE_SCALE_FACTOR)) {
+    osrmc_table_params_set_scale_factor(handle, *scale_factor, error);
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_on = params_typed->alternatives ? 1 : 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_trip_params_set_geometries(osrmc_trip_params_t params, geometries_type_t geometries, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+static void
+osrmc_decode_match(const osrmc_request_reader& match, osrm::MatchParameters& params, osrmc_error_t* error) {
+  osrmc_decode_base(match.table(OSRMC_SERVICE_BASE), params, error);
+  if (*error) {
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  switch (geometries) {
-    case GEOMETRIES_POLYLINE:
-      params_typed->geometries = osrm::RouteParameters::GeometriesType::Polyline;
-      break;
-    case GEOMETRIES_POLYLINE6:
-      params_typed->geometries = osrm::RouteParameters::GeometriesType::Polyline6;
-      break;
-    case GEOMETRIES_GEOJSON:
-      params_typed->geometries = osrm::RouteParameters::GeometriesType::GeoJSON;
-      break;
-    default:
-      osrmc_set_error(error, "InvalidArgument", "Unknown geometries type");
+  osrmc_decode_route_options(match.table(OSRMC_SERVICE_ROUTE), params, error);
+  if (*error) {
+    return;
+  }
+  auto* handle = reinterpret_cast<osrmc_match_params_t>(&params);
+
+  if (const auto* timestamps = match.vector<std::uint32_t>(OSRMC_MATCH_TIMESTAMPS)) {
+    params.timestamps.assign(timestamps->begin(), timestamps->end());
+  }
+  if (const auto gaps = match.scalar<std::int8_t>(OSRMC_MATCH_GAPS)) {
+    osrmc_match_params_set_gaps(handle, static_cast<match_gaps_type_t>(*gaps), error);
+    if (*error) {
       return;
+    }
+  }
+  if (const auto tidy = match.flag(OSRMC_MATCH_TIDY)) {
+    params.tidy = *tidy;
   }
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_trip_params_get_geometries(osrmc_trip_params_t params,
-                                 geometries_type_t* out_geometries,
-                                 osrmc_error_t* error) try {
-  if (!out_geometries) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+static void
+osrmc_decode_trip(const osrmc_request_reader& trip, osrm::TripParameters& params, osrmc_error_t* error) {
+  osrmc_decode_base(trip.table(OSRMC_SERVICE_BASE), params, error);
+  if (*error) {
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  osrmc_decode_route_options(trip.table(OSRMC_SERVICE_ROUTE), params, error);
+  if (*error) {
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  switch (params_typed->geometries) {
-    case osrm::RouteParameters::GeometriesType::Polyline:
-      *out_geometries = GEOMETRIES_POLYLINE;
-      break;
-    case osrm::RouteParameters::GeometriesType::Polyline6:
-      *out_geometries = GEOMETRIES_POLYLINE6;
-      break;
-    case osrm::RouteParameters::GeometriesType::GeoJSON:
-      *out_geometries = GEOMETRIES_GEOJSON;
-      break;
+  auto* handle = reinterpret_cast<osrmc_trip_params_t>(&params);
+
+  if (const auto roundtrip = trip.flag(OSRMC_TRIP_ROUNDTRIP)) {
+    params.roundtrip = *roundtrip;
+  }
+  if (const auto source = trip.scalar<std::int8_t>(OSRMC_TRIP_SOURCE)) {
+    osrmc_trip_params_set_source(handle, static_cast<trip_source_type_t>(*source), error);
+    if (*error) {
+      return;
+    }
+  }
+  if (const auto destination = trip.scalar<std::int8_t>(OSRMC_TRIP_DESTINATION)) {
+    osrmc_trip_params_set_destination(handle, static_cast<trip_destination_type_t>(*destination), error);
   }
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_trip_params_set_overview(osrmc_trip_params_t params, overview_type_t overview, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+static void
+osrmc_decode_tile(const osrmc_request_reader& tile, osrm::TileParameters& params, osrmc_error_t*) {
+  params.x = tile.scalar<std::uint32_t>(OSRMC_TILE_X).value_or(0);
+  params.y = tile.scalar<std::uint32_t>(OSRMC_TILE_Y).value_or(0);
+  params.z = tile.scalar<std::uint32_t>(OSRMC_TILE_Z).value_or(0);
+}
+
+template<typename ParamsHandle, typename ParamsType, typename DecodeFunc>
+static ParamsHandle
+osrmc_params_from_buffer_helper(const uint8_t* data,
+                                size_t size,
+                                osrmc_request_service service,
+                                DecodeFunc decode,
+                                osrmc_error_t* error) try {
+  if (!data) {
+    osrmc_set_error(error, "InvalidArgument", "Buffer must not be null");
+    return nullptr;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  switch (overview) {
-    case OVERVIEW_SIMPLIFIED:
-      params_typed->overview = osrm::RouteParameters::OverviewType::Simplified;
-      break;
-    case OVERVIEW_FULL:
-      params_typed->overview = osrm::RouteParameters::OverviewType::Full;
-      break;
-    case OVERVIEW_FALSE:
-      params_typed->overview = osrm::RouteParameters::OverviewType::False;
-      break;
-    default:
-      osrmc_set_error(error, "InvalidArgument", "Unknown overview type");
-      return;
+  // Root offset followed by the file identifier
+  if (size < 2 * sizeof(flatbuffers::uoffset_t) || !flatbuffers::BufferHasIdentifier(data, "OSRQ") ||
+      flatbuffers::ReadScalar<flatbuffers::uoffset_t>(data) >= size) {
+    osrmc_set_error(error, "InvalidBuffer", "Buffer does not hold an osrmc request");
+    return nullptr;
+  }
+
+  osrmc_request_context context(data, size);
+  const osrmc_request_reader request(context, flatbuffers::GetRoot<flatbuffers::Table>(data));
+  const auto service_type = request.scalar<std::uint8_t>(OSRMC_REQUEST_SERVICE_TYPE);
+  const auto service_table = request.table(OSRMC_REQUEST_SERVICE);
+  if (!context.ok || !service_table) {
+    osrmc_set_error(error, "InvalidBuffer", "Malformed request buffer");
+    return nullptr;
+  }
+  if (service_type.value_or(0) != service) {
+    osrmc_set_error(error, "InvalidBuffer", "Request holds parameters for a different service");
+    return nullptr;
   }
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_trip_params_get_overview(osrmc_trip_params_t params, overview_type_t* out_overview, osrmc_error_t* error) try {
-  if (!out_overview) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+  auto params_typed = osrmc_params_ptr<ParamsType>(osrmc_new_params<ParamsType>());
+  if constexpr (std::is_base_of_v<osrm::engine::api::BaseParameters, ParamsType>) {
+    // Always set FlatBuffer format
+    params_typed->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+
+  osrmc_error_t decode_error = nullptr;
+  decode(service_table, *params_typed, &decode_error);
+  if (!decode_error && !context.ok) {
+    osrmc_set_error(&decode_error, "InvalidBuffer", "Malformed request buffer");
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  switch (params_typed->overview) {
-    case osrm::RouteParameters::OverviewType::Simplified:
-      *out_overview = OVERVIEW_SIMPLIFIED;
-      break;
-    case osrm::RouteParameters::OverviewType::Full:
-      *out_overview = OVERVIEW_FULL;
-      break;
-    case osrm::RouteParameters::OverviewType::False:
-      *out_overview = OVERVIEW_FALSE;
-      break;
+  if (decode_error) {
+    if (error) {
+      *error = decode_error;
+    } else {
+      osrmc_error_destruct(decode_error);
+    }
+    return nullptr;
   }
+  return reinterpret_cast<ParamsHandle>(params_typed.release());
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return nullptr;
 }
 
-void
-osrmc_trip_params_set_continue_straight(osrmc_trip_params_t params, int on, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+osrmc_nearest_params_t
+osrmc_nearest_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error) {
+  return osrmc_params_from_buffer_helper<osrmc_nearest_params_t, osrm::NearestParameters>(
+    data, size, OSRMC_REQUEST_NEAREST, osrmc_decode_nearest, error);
+}
+
+osrmc_route_params_t
+osrmc_route_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error) {
+  return osrmc_params_from_buffer_helper<osrmc_route_params_t, osrm::RouteParameters>(
+    data, size, OSRMC_REQUEST_ROUTE, osrmc_decode_route, error);
+}
+
+osrmc_table_params_t
+osrmc_table_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error) {
+  return osrmc_params_from_buffer_helper<osrmc_table_params_t, osrm::TableParameters>(
+    data, size, OSRMC_REQUEST_TABLE, osrmc_decode_table, error);
+}
+
+osrmc_match_params_t
+osrmc_match_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error) {
+  return osrmc_params_from_buffer_helper<osrmc_match_params_t, osrm::MatchParameters>(
+    data, size, OSRMC_REQUEST_MATCH, osrmc_decode_match, error);
+}
+
+osrmc_trip_params_t
+osrmc_trip_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error) {
+  return osrmc_params_from_buffer_helper<osrmc_trip_params_t, osrm::TripParameters>(
+    data, size, OSRMC_REQUEST_TRIP, osrmc_decode_trip, error);
+}
+
+osrmc_tile_params_t
+osrmc_tile_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error) {
+  return osrmc_params_from_buffer_helper<osrmc_tile_params_t, osrm::TileParameters>(
+    data, size, OSRMC_REQUEST_TILE, osrmc_decode_tile, error);
+}
+
+/* URL requests */
+
+// Calls `visit` for every `separator` delimited item of `list`, empty items included; stops at the first failure
+template<typename VisitFunc>
+static bool
+osrmc_url_for_each(std::string_view list, char separator, VisitFunc visit) {
+  size_t begin = 0;
+  while (true) {
+    const auto end = list.find(separator, begin);
+    if (!visit(list.substr(begin, end - begin))) {
+      return false;
+    }
+    if (end == std::string_view::npos) {
+      return true;
+    }
+    begin = end + 1;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  if (on < 0) {
-    params_typed->continue_straight = std::nullopt;
-  } else {
-    params_typed->continue_straight = (on != 0);
+}
+
+// Parses the whole token as a number, rejecting empty input and trailing characters
+template<typename T>
+static bool
+osrmc_url_parse_number(std::string_view token, T& out) {
+  const char* const last = token.data() + token.size();
+  const auto [end, ec] = std::from_chars(token.data(), last, out);
+  return !token.empty() && ec == std::errc() && end == last;
+}
+
+static bool
+osrmc_url_parse_bool(std::string_view token, bool& out) {
+  if (token == "true" || token == "false") {
+    out = token == "true";
+    return true;
   }
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return false;
 }
 
-void
-osrmc_trip_params_get_continue_straight(osrmc_trip_params_t params,
-                                        int* out_on,
-                                        int* out_is_set,
-                                        osrmc_error_t* error) try {
-  if (!out_on || !out_is_set) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
-    return;
+static int
+osrmc_url_hex_digit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  if (!params_typed->continue_straight) {
-    *out_is_set = 0;
-    return;
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
   }
-  *out_is_set = 1;
-  *out_on = *params_typed->continue_straight ? 1 : 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return -1;
 }
 
-void
-osrmc_trip_params_set_number_of_alternatives(osrmc_trip_params_t params, unsigned count, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+// Percent-decodes the whole request target up front, as osrm-routed does
+static bool
+osrmc_url_decode(std::string_view url, std::string& out) {
+  out.clear();
+  out.reserve(url.size());
+  for (size_t i = 0; i < url.size(); ++i) {
+    if (url[i] != '%') {
+      out.push_back(url[i]);
+      continue;
+    }
+    const int high = i + 2 < url.size() ? osrmc_url_hex_digit(url[i + 1]) : -1;
+    const int low = high >= 0 ? osrmc_url_hex_digit(url[i + 2]) : -1;
+    if (low < 0) {
+      return false;
+    }
+    out.push_back(static_cast<char>(high * 16 + low));
+    i += 2;
+  }
+  return true;
+}
+
+// Decodes a Google encoded polyline (latitude first) with the given precision into longitude/latitude arrays
+static bool
+osrmc_url_decode_polyline(std::string_view encoded,
+                          double precision,
+                          std::vector<double>& longitudes,
+                          std::vector<double>& latitudes) {
+  std::int64_t values[2] = {0, 0};
+  size_t position = 0;
+  while (position < encoded.size()) {
+    for (auto& value : values) {
+      std::uint64_t result = 0;
+      unsigned shift = 0;
+      int chunk = 0;
+      do {
+        if (position >= encoded.size() || shift > 60) {
+          return false;
+        }
+        chunk = encoded[position++] - 63;
+        if (chunk < 0 || chunk > 63) {
+          return false;
+        }
+        result |= static_cast<std::uint64_t>(chunk & 0x1f) << shift;
+        shift += 5;
+      } while (chunk >= 0x20);
+      const auto delta = static_cast<std::int64_t>(result >> 1);
+      value += (result & 1) ? ~delta : delta;
+    }
+    latitudes.push_back(static_cast<double>(values[0]) / precision);
+    longitudes.push_back(static_cast<double>(values[1]) / precision);
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->number_of_alternatives = count;
-  params_typed->alternatives = count > 0;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return true;
 }
 
-void
-osrmc_trip_params_get_number_of_alternatives(osrmc_trip_params_t params,
-                                             unsigned* out_count,
-                                             osrmc_error_t* error) try {
-  if (!out_count) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+static void
+osrmc_url_invalid_value(std::string_view key, osrmc_error_t* error) {
+  const std::string message = "Invalid value for query parameter '" + std::string(key) + "'";
+  osrmc_set_error(error, "InvalidUrl", message.c_str());
+}
+
+// Parses `lon,lat;lon,lat`, `polyline(...)` or `polyline6(...)` with an optional format suffix
+static void
+osrmc_url_parse_coordinates(osrm::engine::api::BaseParameters& params,
+                            std::string_view coordinates,
+                            osrmc_error_t* error) {
+  for (const std::string_view format : {".json", ".flatbuffers"}) {
+    if (coordinates.ends_with(format)) {
+      coordinates.remove_suffix(format.size());
+      break;
+    }
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+
+  std::vector<double> longitudes;
+  std::vector<double> latitudes;
+  bool valid = false;
+  if (coordinates.starts_with("polyline(") && coordinates.ends_with(")")) {
+    valid = osrmc_url_decode_polyline(coordinates.substr(9, coordinates.size() - 10), 1e5, longitudes, latitudes);
+  } else if (coordinates.starts_with("polyline6(") && coordinates.ends_with(")")) {
+    valid = osrmc_url_decode_polyline(coordinates.substr(10, coordinates.size() - 11), 1e6, longitudes, latitudes);
+  } else {
+    osrmc_reserve_additional(longitudes, std::count(coordinates.begin(), coordinates.end(), ';') + 1);
+    osrmc_reserve_additional(latitudes, longitudes.capacity());
+    valid = osrmc_url_for_each(coordinates, ';', [&](std::string_view location) {
+      const auto comma = location.find(',');
+      double longitude = 0;
+      double latitude = 0;
+      if (comma == std::string_view::npos || !osrmc_url_parse_number(location.substr(0, comma), longitude) ||
+          !osrmc_url_parse_number(location.substr(comma + 1), latitude)) {
+        return false;
+      }
+      longitudes.push_back(longitude);
+      latitudes.push_back(latitude);
+      return true;
+    });
+  }
+  if (!valid || longitudes.empty()) {
+    osrmc_set_error(error, "InvalidUrl", "Malformed coordinates");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_count = params_typed->number_of_alternatives;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  osrmc_params_add_coordinates(reinterpret_cast<osrmc_params_t>(&params),
+                               longitudes.data(),
+                               latitudes.data(),
+                               longitudes.size(),
+                               error);
 }
 
-void
-osrmc_trip_params_set_annotations(osrmc_trip_params_t params,
-                                  annotations_type_t annotations,
-                                  osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+static bool
+osrmc_url_parse_indices(std::string_view value, std::vector<size_t>& out) {
+  out.clear();
+  return osrmc_url_for_each(value, ';', [&](std::string_view token) {
+    size_t index = 0;
+    if (!osrmc_url_parse_number(token, index)) {
+      return false;
+    }
+    out.push_back(index);
+    return true;
+  });
+}
+
+// Query parameter handlers return false for keys they do not know and report malformed values through `error`
+static bool
+osrmc_url_apply_base(osrm::engine::api::BaseParameters& params,
+                     std::string_view key,
+                     std::string_view value,
+                     osrmc_error_t* error) {
+  auto* handle = reinterpret_cast<osrmc_params_t>(&params);
+  const size_t count = params.coordinates.size();
+
+  if (key == "bearings") {
+    std::vector<int> values;
+    std::vector<int> ranges;
+    values.reserve(count);
+    ranges.reserve(count);
+    const bool valid = osrmc_url_for_each(value, ';', [&](std::string_view token) {
+      int bearing = -1;
+      int range = -1;
+      if (!token.empty()) {
+        const auto comma = token.find(',');
+        if (comma == std::string_view::npos || !osrmc_url_parse_number(token.substr(0, comma), bearing) ||
+            !osrmc_url_parse_number(token.substr(comma + 1), range) || bearing < 0 || range < 0) {
+          return false;
+        }
+      }
+      values.push_back(bearing);
+      ranges.push_back(range);
+      return true;
+    });
+    if (!valid) {
+      osrmc_url_invalid_value(key, error);
+    } else {
+      osrmc_params_set_bearings(handle, values.data(), ranges.data(), values.size(), error);
+    }
+  } else if (key == "radiuses") {
+    std::vector<double> radiuses;
+    radiuses.reserve(count);
+    const bool valid = osrmc_url_for_each(value, ';', [&](std::string_view token) {
+      double radius = -1.0;
+      if (token == "unlimited") {
+        radius = std::numeric_limits<double>::infinity();
+      } else if (!token.empty() && (!osrmc_url_parse_number(token, radius) || !(radius >= 0.0))) {
+        return false;
+      }
+      radiuses.push_back(radius);
+      return true;
+    });
+    if (!valid) {
+      osrmc_url_invalid_value(key, error);
+    } else {
+      osrmc_params_set_radiuses(handle, radiuses.data(), radiuses.size(), error);
+    }
+  } else if (key == "hints") {
+    // Hints are decoded from NUL terminated strings, so the non-empty ones are copied once
+    std::vector<std::string> storage;
+    osrmc_url_for_each(value, ';', [&](std::string_view token) {
+      storage.emplace_back(token);
+      return true;
+    });
+    std::vector<const char*> hints;
+    hints.reserve(storage.size());
+    for (const auto& hint : storage) {
+      hints.push_back(hint.empty() ? nullptr : hint.c_str());
+    }
+    osrmc_params_set_hints(handle, hints.data(), hints.size(), error);
+  } else if (key == "approaches") {
+    std::vector<std::optional<osrm::engine::Approach>> approaches;
+    approaches.reserve(count);
+    const bool valid = osrmc_url_for_each(value, ';', [&](std::string_view token) {
+      if (token == "curb") {
+        approaches.emplace_back(osrm::engine::Approach::CURB);
+      } else if (token == "unrestricted") {
+        approaches.emplace_back(osrm::engine::Approach::UNRESTRICTED);
+      } else if (token == "opposite") {
+        approaches.emplace_back(osrm::engine::Approach::OPPOSITE);
+      } else if (token.empty()) {
+        approaches.emplace_back(std::nullopt);
+      } else {
+        return false;
+      }
+      return true;
+    });
+    if (!valid) {
+      osrmc_url_invalid_value(key, error);
+    } else if (osrmc_check_coordinate_count(params, approaches.size(), "Approach", error)) {
+      params.approaches = std::move(approaches);
+    }
+  } else if (key == "exclude") {
+    params.exclude.clear();
+    const bool valid = osrmc_url_for_each(value, ',', [&](std::string_view token) {
+      params.exclude.emplace_back(token);
+      return !token.empty();
+    });
+    if (!valid) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "generate_hints") {
+    if (!osrmc_url_parse_bool(value, params.generate_hints)) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "skip_waypoints") {
+    if (!osrmc_url_parse_bool(value, params.skip_waypoints)) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "snapping") {
+    if (value == "default") {
+      osrmc_params_set_snapping(handle, SNAPPING_DEFAULT, error);
+    } else if (value == "any") {
+      osrmc_params_set_snapping(handle, SNAPPING_ANY, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else {
+    return false;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->annotations_type = static_cast<osrm::RouteParameters::AnnotationsType>(annotations);
-  params_typed->annotations = (annotations != ANNOTATIONS_NONE);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return true;
 }
 
-void
-osrmc_trip_params_get_annotations(osrmc_trip_params_t params,
-                                  annotations_type_t* out_annotations,
-                                  osrmc_error_t* error) try {
-  if (!out_annotations) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+// Options shared by route, match and trip requests
+static bool
+osrmc_url_apply_route_options(osrm::RouteParameters& params,
+                              std::string_view key,
+                              std::string_view value,
+                              osrmc_error_t* error) {
+  auto* handle = reinterpret_cast<osrmc_route_params_t>(&params);
+
+  if (key == "steps") {
+    if (!osrmc_url_parse_bool(value, params.steps)) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "alternatives") {
+    bool on = false;
+    unsigned number = 0;
+    if (osrmc_url_parse_bool(value, on)) {
+      osrmc_route_params_set_number_of_alternatives(handle, on ? 1 : 0, error);
+    } else if (osrmc_url_parse_number(value, number)) {
+      osrmc_route_params_set_number_of_alternatives(handle, number, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "annotations") {
+    static constexpr std::pair<std::string_view, unsigned> names[] = {{"duration", ANNOTATIONS_DURATION},
+                                                                      {"nodes", ANNOTATIONS_NODES},
+                                                                      {"distance", ANNOTATIONS_DISTANCE},
+                                                                      {"weight", ANNOTATIONS_WEIGHT},
+                                                                      {"datasources", ANNOTATIONS_DATASOURCES},
+                                                                      {"speed", ANNOTATIONS_SPEED}};
+    unsigned annotations = ANNOTATIONS_NONE;
+    bool valid = true;
+    if (value == "true") {
+      annotations = ANNOTATIONS_ALL;
+    } else if (value != "false") {
+      valid = osrmc_url_for_each(value, ',', [&](std::string_view token) {
+        for (const auto& [name, flag] : names) {
+          if (token == name) {
+            annotations |= flag;
+            return true;
+          }
+        }
+        return false;
+      });
+    }
+    if (!valid) {
+      osrmc_url_invalid_value(key, error);
+    } else {
+      osrmc_route_params_set_annotations(handle, static_cast<annotations_type_t>(annotations), error);
+    }
+  } else if (key == "geometries") {
+    if (value == "polyline") {
+      osrmc_route_params_set_geometries(handle, GEOMETRIES_POLYLINE, error);
+    } else if (value == "polyline6") {
+      osrmc_route_params_set_geometries(handle, GEOMETRIES_POLYLINE6, error);
+    } else if (value == "geojson") {
+      osrmc_route_params_set_geometries(handle, GEOMETRIES_GEOJSON, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "overview") {
+    if (value == "simplified") {
+      osrmc_route_params_set_overview(handle, OVERVIEW_SIMPLIFIED, error);
+    } else if (value == "full") {
+      osrmc_route_params_set_overview(handle, OVERVIEW_FULL, error);
+    } else if (value == "false") {
+      osrmc_route_params_set_overview(handle, OVERVIEW_FALSE, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "continue_straight") {
+    bool on = false;
+    if (value == "default") {
+      osrmc_route_params_set_continue_straight(handle, -1, error);
+    } else if (osrmc_url_parse_bool(value, on)) {
+      osrmc_route_params_set_continue_straight(handle, on ? 1 : 0, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else {
+    return osrmc_url_apply_base(params, key, value, error);
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  return true;
+}
+
+static bool
+osrmc_url_apply_nearest(osrm::NearestParameters& params,
+                        std::string_view key,
+                        std::string_view value,
+                        osrmc_error_t* error) {
+  if (key != "number") {
+    return osrmc_url_apply_base(params, key, value, error);
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_annotations = static_cast<annotations_type_t>(params_typed->annotations_type);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  if (!osrmc_url_parse_number(value, params.number_of_results)) {
+    osrmc_url_invalid_value(key, error);
+  }
+  return true;
 }
 
-void
-osrmc_trip_params_clear_waypoints(osrmc_trip_params_t params, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+static bool
+osrmc_url_apply_route(osrm::RouteParameters& params,
+                      std::string_view key,
+                      std::string_view value,
+                      osrmc_error_t* error) {
+  if (key != "waypoints") {
+    return osrmc_url_apply_route_options(params, key, value, error);
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->waypoints.clear();
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  if (!osrmc_url_parse_indices(value, params.waypoints)) {
+    osrmc_url_invalid_value(key, error);
+  }
+  return true;
 }
 
-void
-osrmc_trip_params_add_waypoint(osrmc_trip_params_t params, size_t index, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+static bool
+osrmc_url_apply_table(osrm::TableParameters& params,
+                      std::string_view key,
+                      std::string_view value,
+                      osrmc_error_t* error) {
+  auto* handle = reinterpret_cast<osrmc_table_params_t>(&params);
+
+  if (key == "sources" || key == "destinations") {
+    auto& indices = key == "sources" ? params.sources : params.destinations;
+    if (value == "all") {
+      indices.clear();
+    } else if (!osrmc_url_parse_indices(value, indices)) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "annotations") {
+    unsigned annotations = TABLE_ANNOTATIONS_NONE;
+    const bool valid = osrmc_url_for_each(value, ',', [&](std::string_view token) {
+      if (token == "duration") {
+        annotations |= TABLE_ANNOTATIONS_DURATION;
+      } else if (token == "distance") {
+        annotations |= TABLE_ANNOTATIONS_DISTANCE;
+      } else {
+        return false;
+      }
+      return true;
+    });
+    if (!valid) {
+      osrmc_url_invalid_value(key, error);
+    } else {
+      osrmc_table_params_set_annotations(handle, static_cast<table_annotations_type_t>(annotations), error);
+    }
+  } else if (key == "fallback_speed" || key == "scale_factor") {
+    double number = 0;
+    if (!osrmc_url_parse_number(value, number)) {
+      osrmc_url_invalid_value(key, error);
+    } else if (key == "fallback_speed") {
+      osrmc_table_params_set_fallback_speed(handle, number, error);
+    } else {
+      osrmc_table_params_set_scale_factor(handle, number, error);
+    }
+  } else if (key == "fallback_coordinate") {
+    if (value == "input") {
+      osrmc_table_params_set_fallback_coordinate_type(handle, TABLE_COORDINATE_INPUT, error);
+    } else if (value == "snapped") {
+      osrmc_table_params_set_fallback_coordinate_type(handle, TABLE_COORDINATE_SNAPPED, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else {
+    return osrmc_url_apply_base(params, key, value, error);
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  params_typed->waypoints.emplace_back(index);
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return true;
 }
 
-void
-osrmc_trip_params_get_waypoint_count(osrmc_trip_params_t params, size_t* out_count, osrmc_error_t* error) try {
-  if (!out_count) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+static bool
+osrmc_url_apply_match(osrm::MatchParameters& params,
+                      std::string_view key,
+                      std::string_view value,
+                      osrmc_error_t* error) {
+  auto* handle = reinterpret_cast<osrmc_match_params_t>(&params);
+
+  if (key == "timestamps") {
+    params.timestamps.clear();
+    params.timestamps.reserve(params.coordinates.size());
+    const bool valid = osrmc_url_for_each(value, ';', [&](std::string_view token) {
+      unsigned timestamp = 0;
+      if (!osrmc_url_parse_number(token, timestamp)) {
+        return false;
+      }
+      params.timestamps.push_back(timestamp);
+      return true;
+    });
+    if (!valid) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "gaps") {
+    if (value == "split") {
+      osrmc_match_params_set_gaps(handle, MATCH_GAPS_SPLIT, error);
+    } else if (value == "ignore") {
+      osrmc_match_params_set_gaps(handle, MATCH_GAPS_IGNORE, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "tidy") {
+    if (!osrmc_url_parse_bool(value, params.tidy)) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else {
+    return osrmc_url_apply_route(params, key, value, error);
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  return true;
+}
+
+static bool
+osrmc_url_apply_trip(osrm::TripParameters& params, std::string_view key, std::string_view value, osrmc_error_t* error) {
+  auto* handle = reinterpret_cast<osrmc_trip_params_t>(&params);
+
+  if (key == "roundtrip") {
+    if (!osrmc_url_parse_bool(value, params.roundtrip)) {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "source") {
+    if (value == "any") {
+      osrmc_trip_params_set_source(handle, TRIP_SOURCE_ANY, error);
+    } else if (value == "first") {
+      osrmc_trip_params_set_source(handle, TRIP_SOURCE_FIRST, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else if (key == "destination") {
+    if (value == "any") {
+      osrmc_trip_params_set_destination(handle, TRIP_DESTINATION_ANY, error);
+    } else if (value == "last") {
+      osrmc_trip_params_set_destination(handle, TRIP_DESTINATION_LAST, error);
+    } else {
+      osrmc_url_invalid_value(key, error);
+    }
+  } else {
+    return osrmc_url_apply_route_options(params, key, value, error);
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  *out_count = params_typed->waypoints.size();
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  return true;
 }
 
-void
-osrmc_trip_params_get_waypoint(osrmc_trip_params_t params, size_t index, size_t* out_index, osrmc_error_t* error) try {
-  if (!out_index) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+template<typename ParamsType, typename ApplyFunc>
+static void*
+osrmc_params_from_url_helper(std::string_view coordinates,
+                             std::string_view query,
+                             ApplyFunc apply,
+                             osrmc_error_t* error) {
+  auto params_typed = osrmc_params_ptr<ParamsType>(osrmc_new_params<ParamsType>());
+  // Always set FlatBuffer format
+  params_typed->format = osrm::engine::api::BaseParameters::OutputFormatType::FLATBUFFERS;
+
+  osrmc_error_t parse_error = nullptr;
+  osrmc_url_parse_coordinates(*params_typed, coordinates, &parse_error);
+  if (!parse_error && !query.empty()) {
+    osrmc_url_for_each(query, '&', [&](std::string_view option) {
+      if (option.empty()) {
+        return true;
+      }
+      const auto equals = option.find('=');
+      const auto key = option.substr(0, equals);
+      const auto value = equals == std::string_view::npos ? std::string_view() : option.substr(equals + 1);
+      if (!apply(*params_typed, key, value, &parse_error) && !parse_error) {
+        const std::string message = "Unknown query parameter '" + std::string(key) + "'";
+        osrmc_set_error(&parse_error, "InvalidUrl", message.c_str());
+      }
+      return !parse_error;
+    });
+  }
+  if (parse_error) {
+    if (error) {
+      *error = parse_error;
+    } else {
+      osrmc_error_destruct(parse_error);
+    }
+    return nullptr;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  return params_typed.release();
+}
+
+// Parses `tile(x,y,z).mvt`; tile requests take no query parameters
+static void*
+osrmc_tile_params_from_url(std::string_view tile, std::string_view query, osrmc_error_t* error) {
+  unsigned xyz[3] = {0, 0, 0};
+  size_t component = 0;
+  const bool valid = tile.starts_with("tile(") && tile.ends_with(").mvt") &&
+                     osrmc_url_for_each(tile.substr(5, tile.size() - 10), ',', [&](std::string_view token) {
+                       return component < 3 && osrmc_url_parse_number(token, xyz[component++]);
+                     }) &&
+                     component == 3;
+  if (!valid) {
+    osrmc_set_error(error, "InvalidUrl", "Malformed tile coordinates");
+    return nullptr;
   }
-  auto* params_typed = reinterpret_cast<osrm::TripParameters*>(params);
-  if (index >= params_typed->waypoints.size()) {
-    osrmc_set_error(error, "InvalidIndex", "Waypoint index out of bounds");
-    return;
+  if (!query.empty()) {
+    osrmc_set_error(error, "InvalidUrl", "Tile requests take no query parameters");
+    return nullptr;
   }
-  *out_index = params_typed->waypoints[index];
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
+  auto params_typed = osrmc_params_ptr<osrm::TileParameters>(osrmc_new_params<osrm::TileParameters>());
+  params_typed->x = xyz[0];
+  params_typed->y = xyz[1];
+  params_typed->z = xyz[2];
+  return params_typed.release();
 }
 
-osrmc_trip_response_t
-osrmc_trip(osrmc_osrm_t osrm, osrmc_trip_params_t params, osrmc_error_t* error) {
-  return osrmc_service_helper<osrmc_trip_params_t, osrm::TripParameters, osrmc_trip_response_t>(
-    osrm,
-    params,
-    [](osrm::OSRM& o, osrm::TripParameters& p, osrm::engine::api::ResultT& r) { return o.Trip(p, r); },
-    "TripError",
-    error);
-}
+void*
+osrmc_params_from_url(const char* url, size_t length, service_type_t* out_service, osrmc_error_t* error) try {
+  if (!out_service) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return nullptr;
+  }
+  if (!url) {
+    osrmc_set_error(error, "InvalidArgument", "URL must not be null");
+    return nullptr;
+  }
 
-void
-osrmc_trip_response_destruct(osrmc_trip_response_t response) {
-  if (response) {
-    delete reinterpret_cast<osrmc_response*>(response);
+  std::string_view target(url, length);
+  std::string decoded;
+  if (target.find('%') != std::string_view::npos) {
+    if (!osrmc_url_decode(target, decoded)) {
+      osrmc_set_error(error, "InvalidUrl", "Malformed percent-encoding");
+      return nullptr;
+    }
+    target = decoded;
+  }
+  // Accept absolute URLs as found in proxy logs by skipping scheme and authority
+  if (const auto scheme = target.find("://"); scheme != std::string_view::npos) {
+    const auto path = target.find('/', scheme + 3);
+    target = path == std::string_view::npos ? std::string_view() : target.substr(path);
+  }
+  target = target.substr(0, target.find('#'));
+  if (target.starts_with('/')) {
+    target.remove_prefix(1);
   }
-}
 
-void
-osrmc_trip_response_transfer_flatbuffer(osrmc_trip_response_t response,
-                                        uint8_t** data,
-                                        size_t* size,
-                                        void (**deleter)(void*),
-                                        osrmc_error_t* error) try {
-  if (!response) {
-    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
-    if (data)
-      *data = nullptr;
-    if (size)
-      *size = 0;
-    if (deleter)
-      *deleter = nullptr;
-    return;
+  // /{service}/v1/{profile}/{coordinates}?{query}
+  std::string_view path_components[3];
+  for (auto& component : path_components) {
+    const auto slash = target.find('/');
+    if (slash == std::string_view::npos || target.substr(0, slash).find('?') != std::string_view::npos) {
+      osrmc_set_error(error, "InvalidUrl", "Expected /{service}/v1/{profile}/{coordinates}");
+      return nullptr;
+    }
+    component = target.substr(0, slash);
+    target.remove_prefix(slash + 1);
   }
-  if (!data || !size || !deleter) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointers must not be null");
-    return;
+  const auto& [service, version, profile] = path_components;
+  if (version != "v1" || profile.empty()) {
+    osrmc_set_error(error, "InvalidUrl", "Expected /{service}/v1/{profile}/{coordinates}");
+    return nullptr;
   }
-  auto* resp = reinterpret_cast<osrmc_response*>(response);
-  osrmc_transfer_flatbuffer_helper(resp, data, size, deleter, error);
+  // Polyline alphabets include '?', so the query starts after the closing parenthesis
+  const size_t polyline_end = target.starts_with("polyline") ? target.find(')') : 0;
+  const auto question = target.find('?', polyline_end == std::string_view::npos ? 0 : polyline_end);
+  const auto coordinates = target.substr(0, question);
+  const auto query = question == std::string_view::npos ? std::string_view() : target.substr(question + 1);
+
+  void* params = nullptr;
+  if (service == "nearest") {
+    *out_service = SERVICE_NEAREST;
+    params = osrmc_params_from_url_helper<osrm::NearestParameters>(coordinates, query, osrmc_url_apply_nearest, error);
+  } else if (service == "route") {
+    *out_service = SERVICE_ROUTE;
+    params = osrmc_params_from_url_helper<osrm::RouteParameters>(coordinates, query, osrmc_url_apply_route, error);
+  } else if (service == "table") {
+    *out_service = SERVICE_TABLE;
+    params = osrmc_params_from_url_helper<osrm::TableParameters>(coordinates, query, osrmc_url_apply_table, error);
+  } else if (service == "match") {
+    *out_service = SERVICE_MATCH;
+    params = osrmc_params_from_url_helper<osrm::MatchParameters>(coordinates, query, osrmc_url_apply_match, error);
+  } else if (service == "trip") {
+    *out_service = SERVICE_TRIP;
+    params = osrmc_params_from_url_helper<osrm::TripParameters>(coordinates, query, osrmc_url_apply_trip, error);
+  } else if (service == "tile") {
+    *out_service = SERVICE_TILE;
+    params = osrmc_tile_params_from_url(coordinates, query, error);
+  } else {
+    osrmc_set_error(error, "InvalidUrl", "Unknown service");
+  }
+  return params;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  if (data)
-    *data = nullptr;
-  if (size)
-    *size = 0;
-  if (deleter)
-    *deleter = nullptr;
+  return nullptr;
 }
 
-/* Tile */
+/* Asynchronous requests */
 
-osrmc_tile_params_t
-osrmc_tile_params_construct(osrmc_error_t* error) try {
-  auto* out = new osrm::TileParameters;
-  out->x = 0;
-  out->y = 0;
-  out->z = 0;
-  return reinterpret_cast<osrmc_tile_params_t>(out);
+struct osrmc_completion_queue final {
+  osrmc_completion_queue() {
+#if defined(__linux__)
+    event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd < 0) {
+      throw std::runtime_error("Failed to create eventfd");
+    }
+#elif !defined(_WIN32)
+    if (pipe(pipe_fds) != 0) {
+      throw std::runtime_error("Failed to create pipe");
+    }
+    for (const int fd : pipe_fds) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+      fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    event_fd = pipe_fds[0];
+#endif
+  }
+
+  ~osrmc_completion_queue() {
+#if defined(__linux__)
+    close(event_fd);
+#elif !defined(_WIN32)
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+#endif
+  }
+
+  osrmc_completion_queue(const osrmc_completion_queue&) = delete;
+  osrmc_completion_queue& operator=(const osrmc_completion_queue&) = delete;
+
+  // Registers an in-flight request; the caller holds no lock
+  uint64_t
+  begin() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++pending;
+    return ++last_ticket;
+  }
+
+  // Undoes begin() when the request could not be started
+  void
+  abandon() {
+    std::lock_guard<std::mutex> lock(mutex);
+    --pending;
+    idle.notify_all();
+  }
+
+  // Called from worker threads; the queue may be destroyed as soon as the lock is released
+  void
+  complete(const osrmc_completion_t& completion) {
+    std::lock_guard<std::mutex> lock(mutex);
+    completed.push_back(completion);
+    if (!signaled) {
+      signal();
+      signaled = true;
+    }
+    --pending;
+    ready.notify_all();
+    idle.notify_all();
+  }
+
+  // Moves up to `max` completions into `out`; requires the lock
+  size_t
+  drain(osrmc_completion_t* out, size_t max) {
+    const size_t count = std::min(max, completed.size());
+    std::copy_n(completed.begin(), count, out);
+    completed.erase(completed.begin(), completed.begin() + count);
+    if (completed.empty() && signaled) {
+      reset();
+      signaled = false;
+    }
+    return count;
+  }
+
+  // Makes the descriptor readable (eventfd counter or a pipe byte)
+  void
+  signal() {
+#if defined(__linux__)
+    const uint64_t one = 1;
+    [[maybe_unused]] const auto written = write(event_fd, &one, sizeof(one));
+#elif !defined(_WIN32)
+    const char byte = 0;
+    [[maybe_unused]] const auto written = write(pipe_fds[1], &byte, sizeof(byte));
+#endif
+  }
+
+  void
+  reset() {
+#if defined(__linux__)
+    uint64_t value = 0;
+    [[maybe_unused]] const auto read_bytes = read(event_fd, &value, sizeof(value));
+#elif !defined(_WIN32)
+    char byte = 0;
+    [[maybe_unused]] const auto read_bytes = read(pipe_fds[0], &byte, sizeof(byte));
+#endif
+  }
+
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::condition_variable idle;
+  std::deque<osrmc_completion_t> completed;
+  size_t pending = 0;
+  uint64_t last_ticket = 0;
+  bool signaled = false;
+  int event_fd = -1;
+#if !defined(__linux__) && !defined(_WIN32)
+  int pipe_fds[2] = {-1, -1};
+#endif
+};
+
+static void
+osrmc_completion_destruct(const osrmc_completion_t& completion) {
+  switch (completion.service) {
+    case SERVICE_NEAREST:
+      osrmc_nearest_response_destruct(static_cast<osrmc_nearest_response_t>(completion.response));
+      break;
+    case SERVICE_ROUTE:
+      osrmc_route_response_destruct(static_cast<osrmc_route_response_t>(completion.response));
+      break;
+    case SERVICE_TABLE:
+      osrmc_table_response_destruct(static_cast<osrmc_table_response_t>(completion.response));
+      break;
+    case SERVICE_MATCH:
+      osrmc_match_response_destruct(static_cast<osrmc_match_response_t>(completion.response));
+      break;
+    case SERVICE_TRIP:
+      osrmc_trip_response_destruct(static_cast<osrmc_trip_response_t>(completion.response));
+      break;
+    case SERVICE_TILE:
+      osrmc_tile_response_destruct(static_cast<osrmc_tile_response_t>(completion.response));
+      break;
+  }
+  osrmc_error_destruct(completion.error);
+}
+
+osrmc_completion_queue_t
+osrmc_completion_queue_construct(osrmc_error_t* error) try {
+  return new osrmc_completion_queue;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
   return nullptr;
 }
 
 void
-osrmc_tile_params_destruct(osrmc_tile_params_t params) {
-  if (params) {
-    delete reinterpret_cast<osrm::TileParameters*>(params);
+osrmc_completion_queue_destruct(osrmc_completion_queue_t queue) {
+  if (!queue) {
+    return;
   }
+  {
+    // In-flight requests still complete into the queue, wait for them
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    queue->idle.wait(lock, [queue] { return queue->pending == 0; });
+  }
+  for (const auto& completion : queue->completed) {
+    osrmc_completion_destruct(completion);
+  }
+  delete queue;
 }
 
 void
-osrmc_tile_params_set_x(osrmc_tile_params_t params, unsigned x, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+osrmc_completion_queue_get_fd(osrmc_completion_queue_t queue, int* out_fd, osrmc_error_t* error) try {
+  if (!out_fd) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
-  params_typed->x = x;
+  if (!queue) {
+    osrmc_set_error(error, "InvalidArgument", "Queue must not be null");
+    return;
+  }
+  if (queue->event_fd < 0) {
+    osrmc_set_error(error, "Unsupported", "Completion queue descriptors are not available on this platform");
+    return;
+  }
+  *out_fd = queue->event_fd;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
 void
-osrmc_tile_params_get_x(osrmc_tile_params_t params, unsigned* out_x, osrmc_error_t* error) try {
-  if (!out_x) {
+osrmc_completion_queue_get_pending(osrmc_completion_queue_t queue, size_t* out_pending, osrmc_error_t* error) try {
+  if (!out_pending) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
     return;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
+  if (!queue) {
+    osrmc_set_error(error, "InvalidArgument", "Queue must not be null");
     return;
   }
-  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
-  *out_x = params_typed->x;
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  *out_pending = queue->pending;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
 }
 
-void
-osrmc_tile_params_set_y(osrmc_tile_params_t params, unsigned y, osrmc_error_t* error) try {
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+size_t
+osrmc_poll(osrmc_completion_queue_t queue, osrmc_completion_t* out, size_t max, osrmc_error_t* error) try {
+  if (max > 0 && !out) {
+    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
+    return 0;
   }
-  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
-  params_typed->y = y;
+  if (!queue) {
+    osrmc_set_error(error, "InvalidArgument", "Queue must not be null");
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return queue->drain(out, max);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return 0;
 }
 
-void
-osrmc_tile_params_get_y(osrmc_tile_params_t params, unsigned* out_y, osrmc_error_t* error) try {
-  if (!out_y) {
+size_t
+osrmc_wait(osrmc_completion_queue_t queue,
+           osrmc_completion_t* out,
+           size_t max,
+           int timeout_ms,
+           osrmc_error_t* error) try {
+  if (max > 0 && !out) {
     osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+    return 0;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (!queue) {
+    osrmc_set_error(error, "InvalidArgument", "Queue must not be null");
+    return 0;
   }
-  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
-  *out_y = params_typed->y;
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  // Nothing in flight and nothing completed means waiting could never succeed
+  const auto has_completions = [queue] { return !queue->completed.empty() || queue->pending == 0; };
+  if (timeout_ms < 0) {
+    queue->ready.wait(lock, has_completions);
+  } else {
+    queue->ready.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_completions);
+  }
+  return queue->drain(out, max);
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return 0;
 }
 
-void
-osrmc_tile_params_set_z(osrmc_tile_params_t params, unsigned z, osrmc_error_t* error) try {
+// Runs the service call on the worker pool of `osrm` and posts the result to the queue. Params are borrowed and
+// must stay alive until the completion has been reaped.
+template<typename ParamsHandle, typename ServiceFunc>
+static uint64_t
+osrmc_submit_helper(osrmc_osrm_t osrm,
+                    ParamsHandle params,
+                    osrmc_completion_queue_t queue,
+                    service_type_t service,
+                    ServiceFunc func,
+                    osrmc_error_t* error) try {
+  if (!osrm) {
+    osrmc_set_error(error, "InvalidArgument", "OSRM instance must not be null");
+    return 0;
+  }
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+    return 0;
+  }
+  if (!queue) {
+    osrmc_set_error(error, "InvalidArgument", "Queue must not be null");
+    return 0;
   }
-  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
-  params_typed->z = z;
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-}
 
-void
-osrmc_tile_params_get_z(osrmc_tile_params_t params, unsigned* out_z, osrmc_error_t* error) try {
-  if (!out_z) {
-    osrmc_set_error(error, "InvalidArgument", "Output pointer must not be null");
-    return;
+  const uint64_t ticket = queue->begin();
+  bool admitted = false;
+  try {
+    admitted = osrmc_schedule_task(osrm, service, params, [osrm, params, queue, service, func, ticket] {
+      osrmc_error_t item_error = nullptr;
+      void* response = func(osrm, params, &item_error);
+      queue->complete(osrmc_completion_t{ticket, service, response, item_error});
+    });
+  } catch (...) {
+    queue->abandon();
+    throw;
   }
-  if (!params) {
-    osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return;
+  if (!admitted) {
+    queue->abandon();
+    osrmc_set_error(error, "Overloaded", "Admission queue is full");
+    return 0;
   }
-  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
-  *out_z = params_typed->z;
+  return ticket;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
+  return 0;
 }
 
-osrmc_tile_response_t
-osrmc_tile(osrmc_osrm_t osrm, osrmc_tile_params_t params, osrmc_error_t* error) try {
+uint64_t
+osrmc_nearest_submit(osrmc_osrm_t osrm,
+                     osrmc_nearest_params_t params,
+                     osrmc_completion_queue_t queue,
+                     osrmc_error_t* error) {
+  return osrmc_submit_helper(osrm, params, queue, SERVICE_NEAREST, osrmc_nearest, error);
+}
+
+uint64_t
+osrmc_route_submit(osrmc_osrm_t osrm,
+                   osrmc_route_params_t params,
+                   osrmc_completion_queue_t queue,
+                   osrmc_error_t* error) {
+  return osrmc_submit_helper(osrm, params, queue, SERVICE_ROUTE, osrmc_route, error);
+}
+
+uint64_t
+osrmc_table_submit(osrmc_osrm_t osrm,
+                   osrmc_table_params_t params,
+                   osrmc_completion_queue_t queue,
+                   osrmc_error_t* error) {
+  return osrmc_submit_helper(osrm, params, queue, SERVICE_TABLE, osrmc_table, error);
+}
+
+uint64_t
+osrmc_match_submit(osrmc_osrm_t osrm,
+                   osrmc_match_params_t params,
+                   osrmc_completion_queue_t queue,
+                   osrmc_error_t* error) {
+  return osrmc_submit_helper(osrm, params, queue, SERVICE_MATCH, osrmc_match, error);
+}
+
+uint64_t
+osrmc_trip_submit(osrmc_osrm_t osrm, osrmc_trip_params_t params, osrmc_completion_queue_t queue, osrmc_error_t* error) {
+  return osrmc_submit_helper(osrm, params, queue, SERVICE_TRIP, osrmc_trip, error);
+}
+
+uint64_t
+osrmc_tile_submit(osrmc_osrm_t osrm, osrmc_tile_params_t params, osrmc_completion_queue_t queue, osrmc_error_t* error) {
+  return osrmc_submit_helper(osrm, params, queue, SERVICE_TILE, osrmc_tile, error);
+}
+
+// Runs the service call on the worker pool of `osrm` and hands the result to `callback` on the worker thread.
+// Params are borrowed and must stay alive until the callback has run.
+template<typename ParamsHandle, typename ResponseHandle, typename ServiceFunc>
+static void
+osrmc_async_helper(osrmc_osrm_t osrm,
+                   ParamsHandle params,
+                   void (*callback)(ResponseHandle, osrmc_error_t, void*),
+                   void* userdata,
+                   service_type_t service,
+                   ServiceFunc func,
+                   osrmc_error_t* error) try {
   if (!osrm) {
     osrmc_set_error(error, "InvalidArgument", "OSRM instance must not be null");
-    return nullptr;
+    return;
   }
   if (!params) {
     osrmc_set_error(error, "InvalidArgument", "Params must not be null");
-    return nullptr;
+    return;
   }
-  auto* osrm_typed = reinterpret_cast<osrm::OSRM*>(osrm);
-  auto* params_typed = reinterpret_cast<osrm::TileParameters*>(params);
-
-  // Tile returns binary data as std::string (not JSON Object)
-  osrm::engine::api::ResultT result = std::string();
-  const auto status = osrm_typed->Tile(*params_typed, result);
-
-  if (status == osrm::Status::Ok) {
-    auto* out = new std::string(std::move(std::get<std::string>(result)));
-    return reinterpret_cast<osrmc_tile_response_t>(out);
+  if (!callback) {
+    osrmc_set_error(error, "InvalidArgument", "Callback must not be null");
+    return;
   }
-
-  if (std::holds_alternative<osrm::json::Object>(result)) {
-    auto& json = std::get<osrm::json::Object>(result);
-    if (error) {
-      auto code = std::get<osrm::json::String>(json.values["code"]).value;
-      auto message = std::get<osrm::json::String>(json.values["message"]).value;
-      if (code.empty()) {
-        code = "Unknown";
-      }
-      osrmc_set_error(error, code.c_str(), message.c_str());
-    }
-  } else {
-    osrmc_set_error(error, "TileError", "Failed to generate tile");
+  const bool admitted = osrmc_schedule_task(osrm, service, params, [osrm, params, callback, userdata, func] {
+    osrmc_error_t item_error = nullptr;
+    ResponseHandle response = func(osrm, params, &item_error);
+    callback(response, item_error, userdata);
+  });
+  if (!admitted) {
+    osrmc_set_error(error, "Overloaded", "Admission queue is full");
   }
-
-  return nullptr;
 } catch (const std::exception& e) {
   osrmc_error_from_exception(e, error);
-  return nullptr;
 }
 
 void
-osrmc_tile_response_destruct(osrmc_tile_response_t response) {
-  if (response) {
-    delete reinterpret_cast<std::string*>(response);
-  }
+osrmc_nearest_async(osrmc_osrm_t osrm,
+                    osrmc_nearest_params_t params,
+                    osrmc_nearest_callback_t callback,
+                    void* userdata,
+                    osrmc_error_t* error) {
+  osrmc_async_helper(osrm, params, callback, userdata, SERVICE_NEAREST, osrmc_nearest, error);
 }
 
-size_t
-osrmc_tile_response_size(osrmc_tile_response_t response, osrmc_error_t* error) try {
-  if (!response) {
-    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
-    return 0;
-  }
-  auto* response_typed = reinterpret_cast<std::string*>(response);
-  return response_typed->size();
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-  return 0;
+void
+osrmc_route_async(osrmc_osrm_t osrm,
+                  osrmc_route_params_t params,
+                  osrmc_route_callback_t callback,
+                  void* userdata,
+                  osrmc_error_t* error) {
+  osrmc_async_helper(osrm, params, callback, userdata, SERVICE_ROUTE, osrmc_route, error);
 }
 
-const char*
-osrmc_tile_response_data(osrmc_tile_response_t response, size_t* size, osrmc_error_t* error) try {
-  if (!response) {
-    osrmc_set_error(error, "InvalidArgument", "Response must not be null");
-    if (size) {
-      *size = 0;
-    }
-    return nullptr;
-  }
-  auto* response_typed = reinterpret_cast<std::string*>(response);
+void
+osrmc_table_async(osrmc_osrm_t osrm,
+                  osrmc_table_params_t params,
+                  osrmc_table_callback_t callback,
+                  void* userdata,
+                  osrmc_error_t* error) {
+  osrmc_async_helper(osrm, params, callback, userdata, SERVICE_TABLE, osrmc_table, error);
+}
 
-  if (size) {
-    *size = response_typed->size();
-  }
+void
+osrmc_match_async(osrmc_osrm_t osrm,
+                  osrmc_match_params_t params,
+                  osrmc_match_callback_t callback,
+                  void* userdata,
+                  osrmc_error_t* error) {
+  osrmc_async_helper(osrm, params, callback, userdata, SERVICE_MATCH, osrmc_match, error);
+}
 
-  return response_typed->data();
-} catch (const std::exception& e) {
-  osrmc_error_from_exception(e, error);
-  if (size) {
-    *size = 0;
-  }
-  return nullptr;
+void
+osrmc_trip_async(osrmc_osrm_t osrm,
+                 osrmc_trip_params_t params,
+                 osrmc_trip_callback_t callback,
+                 void* userdata,
+                 osrmc_error_t* error) {
+  osrmc_async_helper(osrm, params, callback, userdata, SERVICE_TRIP, osrmc_trip, error);
+}
+
+void
+osrmc_tile_async(osrmc_osrm_t osrm,
+                 osrmc_tile_params_t params,
+                 osrmc_tile_callback_t callback,
+                 void* userdata,
+                 osrmc_error_t* error) {
+  osrmc_async_helper(osrm, params, callback, userdata, SERVICE_TILE, osrmc_tile, error);
 }
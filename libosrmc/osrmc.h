@@ -99,9 +99,24 @@ typedef struct osrmc_trip_response* osrmc_trip_response_t;
 // Tile
 typedef struct osrmc_tile_params* osrmc_tile_params_t;
 typedef struct osrmc_tile_response* osrmc_tile_response_t;
+// Cancellation token
+typedef struct osrmc_cancel_token* osrmc_cancel_token_t;
+// Completion queue
+typedef struct osrmc_completion_queue* osrmc_completion_queue_t;
 
 /* Enums */
 
+// Services
+typedef enum {
+  SERVICE_NEAREST = 0,
+  SERVICE_ROUTE = 1,
+  SERVICE_TABLE = 2,
+  SERVICE_MATCH = 3,
+  SERVICE_TRIP = 4,
+  SERVICE_TILE = 5
+} service_type_t;
+// Admission lanes
+typedef enum { LANE_INTERACTIVE = 0, LANE_BULK = 1 } lane_t;
 // Algorithms
 typedef enum { ALGORITHM_CH = 0, ALGORITHM_MLD = 1 } algorithm_t;
 // Snapping
@@ -132,6 +147,10 @@ typedef enum {
 } table_annotations_type_t;
 // Table coordinate
 typedef enum { TABLE_COORDINATE_INPUT = 0, TABLE_COORDINATE_SNAPPED = 1 } table_coordinate_type_t;
+// Matrix layout
+typedef enum { MATRIX_ROW_MAJOR = 0, MATRIX_COLUMN_MAJOR = 1 } matrix_order_t;
+// Quantized matrix cell of an unreachable pair (see osrmc_table_response_get_durations)
+#define OSRMC_MATRIX_UNREACHABLE UINT32_MAX
 // Match gaps
 typedef enum { MATCH_GAPS_SPLIT = 0, MATCH_GAPS_IGNORE = 1 } match_gaps_type_t;
 // Trip source
@@ -225,15 +244,163 @@ OSRMC_API void
 osrmc_config_get_dataset_name(osrmc_config_t config, const char** out_dataset_name, osrmc_error_t* error);
 OSRMC_API void
 osrmc_config_clear_disabled_feature_datasets(osrmc_config_t config, osrmc_error_t* error);
+// Worker pool used by batch, asynchronous and parallel calls, started on first use: thread count (0 = one per
+// core), CPUs to pin workers to round-robin (empty = no pinning, Linux only) and stack size (0 = platform default)
+OSRMC_API void
+osrmc_config_set_worker_threads(osrmc_config_t config, int threads, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_worker_threads(osrmc_config_t config, int* out_threads, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_set_worker_cpus(osrmc_config_t config, const int* cpus, size_t count, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_worker_cpu_count(osrmc_config_t config, size_t* out_count, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_worker_cpu(osrmc_config_t config, size_t index, int* out_cpu, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_set_worker_stack_size(osrmc_config_t config, size_t stack_size, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_worker_stack_size(osrmc_config_t config, size_t* out_stack_size, osrmc_error_t* error);
+// Admission control, active once any concurrency limit is set (0 = unlimited): requests beyond the instance, lane
+// or service limit wait in a per-lane queue (default capacity 1024) and fail with "Overloaded" when it is full.
+// Freed slots go to the interactive lane first; within a lane, tenants share slots in proportion to their weights
+// (default 1). By default Nearest, Route and Tile are interactive, Table, Match and Trip are bulk. A batch or
+// osrmc_match_traces call is admitted once, as a request of its first item or template, and runs on as many threads
+// as slots were free for it. Calls made on the worker pool, from callbacks for example, run without waiting.
+OSRMC_API void
+osrmc_config_set_max_active_requests(osrmc_config_t config, unsigned max_active, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_max_active_requests(osrmc_config_t config, unsigned* out_max_active, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_set_lane_limit(osrmc_config_t config, lane_t lane, unsigned max_active, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_lane_limit(osrmc_config_t config, lane_t lane, unsigned* out_max_active, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_set_lane_queue_capacity(osrmc_config_t config, lane_t lane, size_t capacity, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_lane_queue_capacity(osrmc_config_t config,
+                                     lane_t lane,
+                                     size_t* out_capacity,
+                                     osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_set_service_limit(osrmc_config_t config,
+                               service_type_t service,
+                               unsigned max_active,
+                               osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_service_limit(osrmc_config_t config,
+                               service_type_t service,
+                               unsigned* out_max_active,
+                               osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_set_service_lane(osrmc_config_t config, service_type_t service, lane_t lane, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_service_lane(osrmc_config_t config, service_type_t service, lane_t* out_lane, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_set_tenant_weight(osrmc_config_t config, uint32_t tenant, unsigned weight, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_tenant_weight(osrmc_config_t config, uint32_t tenant, unsigned* out_weight, osrmc_error_t* error);
+// Request coalescing (default off): identical requests that overlap in time run the engine once and every caller
+// gets its own copy of the result. Callers still apply their own deadline and cancellation token while waiting.
+OSRMC_API void
+osrmc_config_set_coalesce_requests(osrmc_config_t config, bool coalesce_requests, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_coalesce_requests(osrmc_config_t config, bool* out_coalesce_requests, osrmc_error_t* error);
+// Tiled tables (default off): allow tiled Table requests whose matrix exceeds max_locations_distance_table^2
+// cells; each block stays within the limit either way
+OSRMC_API void
+osrmc_config_set_allow_large_tiled_tables(osrmc_config_t config, bool allow, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_allow_large_tiled_tables(osrmc_config_t config, bool* out_allow, osrmc_error_t* error);
+// Response allocator, compatible with flatbuffers::Allocator: response FlatBuffers are built directly in memory
+// from `allocate`. `reallocate_downward` may be NULL (allocate, copy the used parts, deallocate); allocation
+// failures return NULL. Callbacks may run on any thread, also after the OSRM instance is destroyed, for as long as
+// a response or detached buffer built with them is alive.
+typedef struct {
+  uint8_t* (*allocate)(size_t size, void* userdata);
+  void (*deallocate)(uint8_t* p, size_t size, void* userdata);
+  uint8_t* (*reallocate_downward)(uint8_t* old_p,
+                                  size_t old_size,
+                                  size_t new_size,
+                                  size_t in_use_back,
+                                  size_t in_use_front,
+                                  void* userdata);
+  void* userdata;
+} osrmc_allocator_t;
+// Response allocator of every request of the OSRM instance (NULL = default allocator); a request allocator set
+// with osrmc_params_set_allocator takes precedence. The getter zeroes `out_allocator` when none is set.
+OSRMC_API void
+osrmc_config_set_allocator(osrmc_config_t config, const osrmc_allocator_t* allocator, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_allocator(osrmc_config_t config, osrmc_allocator_t* out_allocator, osrmc_error_t* error);
+// Response pooling (default capacity 0 = off): destructed responses and their grown FlatBuffer builders are kept
+// per thread, up to `capacity` of them, and reused by the next request on that thread. Beyond that they go to a
+// pool shared by all threads, up to `capacity` more, so responses built on worker threads and destructed on another
+// thread are reused by the workers. Builders whose buffer grew beyond `max_buffer_size` bytes (0 = no limit) are
+// released instead of kept. Pools are shared by all instances: a pooled builder is also released when it exceeds
+// the limit of the instance reusing it, and pooled responses are freed once the last instance pooling them is
+// destroyed.
+OSRMC_API void
+osrmc_config_set_response_pool(osrmc_config_t config, size_t capacity, size_t max_buffer_size, osrmc_error_t* error);
+OSRMC_API void
+osrmc_config_get_response_pool(osrmc_config_t config,
+                               size_t* out_capacity,
+                               size_t* out_max_buffer_size,
+                               osrmc_error_t* error);
 
 /* OSRM */
 
-// OSRM constructor and destructor
+// OSRM constructor and destructor (the destructor finishes work still queued on the worker pool). Called from a
+// callback running on the instance's own worker pool, the destructor returns at once and the instance is destroyed
+// on a separate thread after the callback returns.
 OSRMC_API osrmc_osrm_t
 osrmc_osrm_construct(osrmc_config_t config, osrmc_error_t* error);
 OSRMC_API void
 osrmc_osrm_destruct(osrmc_osrm_t osrm);
 
+/* Request control */
+
+// Monotonic clock in milliseconds that deadlines are measured against
+OSRMC_API int64_t
+osrmc_now_ms(void);
+// Cancellation token constructor and destructor (params holding the token keep it alive)
+OSRMC_API osrmc_cancel_token_t
+osrmc_cancel_token_construct(osrmc_error_t* error);
+OSRMC_API void
+osrmc_cancel_token_destruct(osrmc_cancel_token_t token);
+// Cancellation token signalling (thread-safe, one-way) and getter
+OSRMC_API void
+osrmc_cancel_token_cancel(osrmc_cancel_token_t token, osrmc_error_t* error);
+OSRMC_API void
+osrmc_cancel_token_is_cancelled(osrmc_cancel_token_t token, int* out_cancelled, osrmc_error_t* error);
+// Request controls for any params handle, tile params included (cast to osrmc_params_t). Requests whose deadline
+// has passed or whose token is cancelled fail with error code "Timeout" or "Cancelled". OSRM cannot interrupt a
+// running query, so controls are checked when a request starts (including when it leaves a worker queue) and when
+// it returns, where a late result is dropped; a query the engine has started always runs to completion. Only tiled
+// Table requests and table streams check again between blocks and skip the blocks not yet started. Controls belong
+// to the params handle and must not be changed while a request using it is running. Deadlines are absolute
+// osrmc_now_ms() values, 0 clears; a timeout sets the deadline `timeout_ms` from now. A NULL token detaches the
+// current one. Controls are cleared by reset and not copied by clone.
+OSRMC_API void
+osrmc_params_set_deadline(osrmc_params_t params, int64_t deadline_ms, osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_get_deadline(osrmc_params_t params, int64_t* out_deadline_ms, osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_set_timeout(osrmc_params_t params, unsigned timeout_ms, osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_set_cancel_token(osrmc_params_t params, osrmc_cancel_token_t token, osrmc_error_t* error);
+// Tenant the request is scheduled for by admission control (default 0); cleared by reset, not copied by clone
+OSRMC_API void
+osrmc_params_set_tenant(osrmc_params_t params, uint32_t tenant, osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_get_tenant(osrmc_params_t params, uint32_t* out_tenant, osrmc_error_t* error);
+// Response allocator of the request (NULL = the allocator of the OSRM instance); cleared by reset, not copied by
+// clone. Zero-copy detach hands out the allocator's own memory; the other transfer functions copy it to malloc.
+// The getter zeroes `out_allocator` when none is set.
+OSRMC_API void
+osrmc_params_set_allocator(osrmc_params_t params, const osrmc_allocator_t* allocator, osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_get_allocator(osrmc_params_t params, osrmc_allocator_t* out_allocator, osrmc_error_t* error);
+
 /* Base */
 
 // Base parameter setters and getters (shared between all services)
@@ -255,6 +422,40 @@ osrmc_params_add_coordinate_with(osrmc_params_t params,
                                  int bearing,
                                  int range,
                                  osrmc_error_t* error);
+// Bulk coordinate setters: separate longitude/latitude arrays or interleaved lon,lat pairs in degrees, or
+// pre-quantized OSRM fixed point (degrees * 1e6). Input is range and NaN checked; on error nothing is added.
+OSRMC_API void
+osrmc_params_add_coordinates(osrmc_params_t params,
+                             const double* longitudes,
+                             const double* latitudes,
+                             size_t count,
+                             osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_add_coordinates_interleaved(osrmc_params_t params,
+                                         const double* lonlat,
+                                         size_t count,
+                                         osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_add_coordinates_fixed(osrmc_params_t params,
+                                   const int32_t* longitudes,
+                                   const int32_t* latitudes,
+                                   size_t count,
+                                   osrmc_error_t* error);
+// Bulk coordinate getters: copy `count` coordinates starting at index `first` into caller arrays
+OSRMC_API void
+osrmc_params_get_coordinates(osrmc_params_t params,
+                             size_t first,
+                             size_t count,
+                             double* out_longitudes,
+                             double* out_latitudes,
+                             osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_get_coordinates_fixed(osrmc_params_t params,
+                                   size_t first,
+                                   size_t count,
+                                   int32_t* out_longitudes,
+                                   int32_t* out_latitudes,
+                                   osrmc_error_t* error);
 OSRMC_API void
 osrmc_params_set_hint(osrmc_params_t params, size_t coordinate_index, const char* hint_base64, osrmc_error_t* error);
 OSRMC_API void
@@ -262,6 +463,24 @@ osrmc_params_get_hint(osrmc_params_t params,
                       size_t coordinate_index,
                       const char** out_hint_base64,
                       osrmc_error_t* error);
+// Binary hints: the raw bytes of one or more fixed-size segment hints, skipping base64. Sizes are multiples of
+// osrmc_hint_segment_size(); a NULL setter input unsets the hint, an unset hint reports size 0. A NULL getter
+// output only reports the size.
+OSRMC_API size_t
+osrmc_hint_segment_size(void);
+OSRMC_API void
+osrmc_params_set_hint_binary(osrmc_params_t params,
+                             size_t coordinate_index,
+                             const uint8_t* data,
+                             size_t size,
+                             osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_get_hint_binary(osrmc_params_t params,
+                             size_t coordinate_index,
+                             uint8_t* out_data,
+                             size_t capacity,
+                             size_t* out_size,
+                             osrmc_error_t* error);
 OSRMC_API void
 osrmc_params_set_radius(osrmc_params_t params, size_t coordinate_index, double radius, osrmc_error_t* error);
 OSRMC_API void
@@ -287,6 +506,31 @@ osrmc_params_get_approach(osrmc_params_t params,
                           approach_t* out_approach,
                           int* out_is_set,
                           osrmc_error_t* error);
+// Per-coordinate array setters: `count` must match the coordinate count. Unset sentinels are the same as for the
+// single-index setters: NULL hint, negative radius, negative bearing value or range, approach outside approach_t.
+OSRMC_API void
+osrmc_params_set_hints(osrmc_params_t params, const char* const* hints_base64, size_t count, osrmc_error_t* error);
+// Binary hints for all coordinates, concatenated in `data` with per-coordinate `sizes` (0 = unset), as written by
+// the response hint getters
+OSRMC_API void
+osrmc_params_set_hints_binary(osrmc_params_t params,
+                              const uint8_t* data,
+                              const size_t* sizes,
+                              size_t count,
+                              osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_set_radiuses(osrmc_params_t params, const double* radiuses, size_t count, osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_set_bearings(osrmc_params_t params,
+                          const int* values,
+                          const int* ranges,
+                          size_t count,
+                          osrmc_error_t* error);
+OSRMC_API void
+osrmc_params_set_approaches(osrmc_params_t params,
+                            const approach_t* approaches,
+                            size_t count,
+                            osrmc_error_t* error);
 OSRMC_API void
 osrmc_params_add_exclude(osrmc_params_t params, const char* exclude_profile, osrmc_error_t* error);
 OSRMC_API void
@@ -313,6 +557,17 @@ OSRMC_API osrmc_nearest_params_t
 osrmc_nearest_params_construct(osrmc_error_t* error);
 OSRMC_API void
 osrmc_nearest_params_destruct(osrmc_nearest_params_t params);
+// Nearest parameter reset (back to defaults, keeps allocated capacity for reuse)
+OSRMC_API void
+osrmc_nearest_params_reset(osrmc_nearest_params_t params, osrmc_error_t* error);
+// Nearest parameter clone (deep copy, destroy with osrmc_nearest_params_destruct)
+OSRMC_API osrmc_nearest_params_t
+osrmc_nearest_params_clone(osrmc_nearest_params_t params, osrmc_error_t* error);
+// Nearest parameter template (copies all options, clears per-coordinate data and index lists keeping capacity)
+OSRMC_API void
+osrmc_nearest_params_apply_template(osrmc_nearest_params_t params,
+                                    osrmc_nearest_params_t template_params,
+                                    osrmc_error_t* error);
 // Nearest parameter setters and getters
 OSRMC_API void
 osrmc_nearest_params_set_number_of_results(osrmc_nearest_params_t params, unsigned n, osrmc_error_t* error);
@@ -324,6 +579,13 @@ OSRMC_API osrmc_nearest_response_t
 osrmc_nearest(osrmc_osrm_t osrm, osrmc_nearest_params_t params, osrmc_error_t* error);
 OSRMC_API void
 osrmc_nearest_response_destruct(osrmc_nearest_response_t response);
+// Nearest batch (runs the requests on the worker pool; responses and errors, if given, are per item)
+OSRMC_API void
+osrmc_nearest_batch(osrmc_osrm_t osrm,
+                    const osrmc_nearest_params_t* params,
+                    size_t n,
+                    osrmc_nearest_response_t* out,
+                    osrmc_error_t* errors);
 // Nearest response getters (transfer ownership to caller)
 OSRMC_API void
 osrmc_nearest_response_transfer_flatbuffer(osrmc_nearest_response_t response,
@@ -331,6 +593,29 @@ osrmc_nearest_response_transfer_flatbuffer(osrmc_nearest_response_t response,
                                            size_t* size,
                                            void (**deleter)(void*),
                                            osrmc_error_t* error);
+// Nearest response zero-copy transfer: *data points into the response buffer owned by *owner, release it with
+// (*deleter)(*owner); no copy is made and the response is left empty
+OSRMC_API void
+osrmc_nearest_response_detach_flatbuffer(osrmc_nearest_response_t response,
+                                         uint8_t** data,
+                                         size_t* size,
+                                         void** owner,
+                                         void (**deleter)(void*),
+                                         osrmc_error_t* error);
+// Nearest response hints (binary, one entry per waypoint): count and total size, then the
+// concatenated hints with per-waypoint sizes for osrmc_params_set_hints_binary
+OSRMC_API void
+osrmc_nearest_response_get_hint_count(osrmc_nearest_response_t response,
+                                      size_t* out_count,
+                                      size_t* out_size,
+                                      osrmc_error_t* error);
+OSRMC_API void
+osrmc_nearest_response_get_hints(osrmc_nearest_response_t response,
+                                 uint8_t* out_data,
+                                 size_t capacity,
+                                 size_t* out_sizes,
+                                 size_t count,
+                                 osrmc_error_t* error);
 
 /* Route */
 
@@ -339,6 +624,17 @@ OSRMC_API osrmc_route_params_t
 osrmc_route_params_construct(osrmc_error_t* error);
 OSRMC_API void
 osrmc_route_params_destruct(osrmc_route_params_t params);
+// Route parameter reset (back to defaults, keeps allocated capacity for reuse)
+OSRMC_API void
+osrmc_route_params_reset(osrmc_route_params_t params, osrmc_error_t* error);
+// Route parameter clone (deep copy, destroy with osrmc_route_params_destruct)
+OSRMC_API osrmc_route_params_t
+osrmc_route_params_clone(osrmc_route_params_t params, osrmc_error_t* error);
+// Route parameter template (copies all options, clears per-coordinate data and index lists keeping capacity)
+OSRMC_API void
+osrmc_route_params_apply_template(osrmc_route_params_t params,
+                                  osrmc_route_params_t template_params,
+                                  osrmc_error_t* error);
 // Route parameter setters and getters
 OSRMC_API void
 osrmc_route_params_set_steps(osrmc_route_params_t params, int on, osrmc_error_t* error);
@@ -381,12 +677,25 @@ OSRMC_API void
 osrmc_route_params_get_waypoint(osrmc_route_params_t params, size_t index, size_t* out_index, osrmc_error_t* error);
 OSRMC_API void
 osrmc_route_params_clear_waypoints(osrmc_route_params_t params, osrmc_error_t* error);
+// Replace all waypoints with an index list
+OSRMC_API void
+osrmc_route_params_set_waypoints(osrmc_route_params_t params,
+                                 const size_t* indices,
+                                 size_t count,
+                                 osrmc_error_t* error);
 
 // Route response constructor and destructor
 OSRMC_API osrmc_route_response_t
 osrmc_route(osrmc_osrm_t osrm, osrmc_route_params_t params, osrmc_error_t* error);
 OSRMC_API void
 osrmc_route_response_destruct(osrmc_route_response_t response);
+// Route batch (runs the requests on the worker pool; responses and errors, if given, are per item)
+OSRMC_API void
+osrmc_route_batch(osrmc_osrm_t osrm,
+                  const osrmc_route_params_t* params,
+                  size_t n,
+                  osrmc_route_response_t* out,
+                  osrmc_error_t* errors);
 // Route response getters (transfer ownership to caller)
 OSRMC_API void
 osrmc_route_response_transfer_flatbuffer(osrmc_route_response_t response,
@@ -394,6 +703,29 @@ osrmc_route_response_transfer_flatbuffer(osrmc_route_response_t response,
                                          size_t* size,
                                          void (**deleter)(void*),
                                          osrmc_error_t* error);
+// Route response zero-copy transfer: *data points into the response buffer owned by *owner, release it with
+// (*deleter)(*owner); no copy is made and the response is left empty
+OSRMC_API void
+osrmc_route_response_detach_flatbuffer(osrmc_route_response_t response,
+                                       uint8_t** data,
+                                       size_t* size,
+                                       void** owner,
+                                       void (**deleter)(void*),
+                                       osrmc_error_t* error);
+// Route response hints (binary, one entry per waypoint): count and total size, then the
+// concatenated hints with per-waypoint sizes for osrmc_params_set_hints_binary
+OSRMC_API void
+osrmc_route_response_get_hint_count(osrmc_route_response_t response,
+                                    size_t* out_count,
+                                    size_t* out_size,
+                                    osrmc_error_t* error);
+OSRMC_API void
+osrmc_route_response_get_hints(osrmc_route_response_t response,
+                               uint8_t* out_data,
+                               size_t capacity,
+                               size_t* out_sizes,
+                               size_t count,
+                               osrmc_error_t* error);
 
 /* Table */
 
@@ -402,6 +734,17 @@ OSRMC_API osrmc_table_params_t
 osrmc_table_params_construct(osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_params_destruct(osrmc_table_params_t params);
+// Table parameter reset (back to defaults, keeps allocated capacity for reuse)
+OSRMC_API void
+osrmc_table_params_reset(osrmc_table_params_t params, osrmc_error_t* error);
+// Table parameter clone (deep copy, destroy with osrmc_table_params_destruct)
+OSRMC_API osrmc_table_params_t
+osrmc_table_params_clone(osrmc_table_params_t params, osrmc_error_t* error);
+// Table parameter template (copies all options, clears per-coordinate data and index lists keeping capacity)
+OSRMC_API void
+osrmc_table_params_apply_template(osrmc_table_params_t params,
+                                  osrmc_table_params_t template_params,
+                                  osrmc_error_t* error);
 // Table parameter setters and getters
 OSRMC_API void
 osrmc_table_params_add_source(osrmc_table_params_t params, size_t index, osrmc_error_t* error);
@@ -409,12 +752,25 @@ OSRMC_API void
 osrmc_table_params_get_source_count(osrmc_table_params_t params, size_t* out_count, osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_params_get_source(osrmc_table_params_t params, size_t index, size_t* out_index, osrmc_error_t* error);
+// Replace all sources with an index list, or with the contiguous coordinate range [first, first + count)
+OSRMC_API void
+osrmc_table_params_set_sources(osrmc_table_params_t params, const size_t* indices, size_t count, osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_params_set_source_range(osrmc_table_params_t params, size_t first, size_t count, osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_params_add_destination(osrmc_table_params_t params, size_t index, osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_params_get_destination_count(osrmc_table_params_t params, size_t* out_count, osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_params_get_destination(osrmc_table_params_t params, size_t index, size_t* out_index, osrmc_error_t* error);
+// Replace all destinations with an index list, or with the contiguous coordinate range [first, first + count)
+OSRMC_API void
+osrmc_table_params_set_destinations(osrmc_table_params_t params,
+                                    const size_t* indices,
+                                    size_t count,
+                                    osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_params_set_destination_range(osrmc_table_params_t params, size_t first, size_t count, osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_params_set_annotations(osrmc_table_params_t params,
                                    table_annotations_type_t annotations,
@@ -439,12 +795,55 @@ OSRMC_API void
 osrmc_table_params_set_scale_factor(osrmc_table_params_t params, double scale_factor, osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_params_get_scale_factor(osrmc_table_params_t params, double* out_scale_factor, osrmc_error_t* error);
+// Tiled execution: matrices larger than rows x cols are split into blocks of at most that size, which run in
+// parallel on the worker pool and are stitched into one response (0 = no split along that axis, 0 x 0 = off).
+// Blocks run on one thread per admission slot the request holds or finds free. Every block is a separate engine
+// request bounded by max_locations_distance_table; the whole matrix is bounded by it too unless the instance
+// allows large tiled tables (osrmc_config_set_allow_large_tiled_tables). A stitched response must fit
+// in one FlatBuffer (2 GiB), so larger matrices fail with "TooBig"; use osrmc_table_stream for those. Cleared by
+// reset, not copied by clone.
+OSRMC_API void
+osrmc_table_params_set_tile_size(osrmc_table_params_t params, size_t rows, size_t cols, osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_params_get_tile_size(osrmc_table_params_t params, size_t* out_rows, size_t* out_cols, osrmc_error_t* error);
 
 // Table response constructor and destructor
 OSRMC_API osrmc_table_response_t
 osrmc_table(osrmc_osrm_t osrm, osrmc_table_params_t params, osrmc_error_t* error);
 OSRMC_API void
 osrmc_table_response_destruct(osrmc_table_response_t response);
+// Table batch (runs the requests on the worker pool; responses and errors, if given, are per item)
+OSRMC_API void
+osrmc_table_batch(osrmc_osrm_t osrm,
+                  const osrmc_table_params_t* params,
+                  size_t n,
+                  osrmc_table_response_t* out,
+                  osrmc_error_t* errors);
+// Table stream block: rows [row_begin, row_begin + row_count) and columns [col_begin, col_begin + col_count) of
+// the full matrix. `durations` and `distances` are row-major row_count x col_count views into `response` (NULL
+// when not requested); waypoint indices of `response` are local to the block. Everything is borrowed for the
+// duration of the callback only.
+typedef struct {
+  size_t row_begin;
+  size_t row_count;
+  size_t col_begin;
+  size_t col_count;
+  const float* durations;
+  const float* distances;
+  osrmc_table_response_t response;
+} osrmc_table_block_t;
+// Table stream callback, return nonzero to stop the stream
+typedef int (*osrmc_table_block_callback_t)(const osrmc_table_block_t* block, void* userdata);
+// Table stream: computes a matrix of any size block by block, in row order, and hands each block to `callback`
+// before computing the next. Blocks span whole rows unless a single row exceeds the limits; they hold at most
+// max_locations_distance_table^2 cells and roughly `memory_budget` bytes of matrix data (0 = no budget).
+OSRMC_API void
+osrmc_table_stream(osrmc_osrm_t osrm,
+                   osrmc_table_params_t params,
+                   size_t memory_budget,
+                   osrmc_table_block_callback_t callback,
+                   void* userdata,
+                   osrmc_error_t* error);
 // Table response getters (transfer ownership to caller)
 OSRMC_API void
 osrmc_table_response_transfer_flatbuffer(osrmc_table_response_t response,
@@ -452,6 +851,83 @@ osrmc_table_response_transfer_flatbuffer(osrmc_table_response_t response,
                                          size_t* size,
                                          void (**deleter)(void*),
                                          osrmc_error_t* error);
+// Table response zero-copy transfer: *data points into the response buffer owned by *owner, release it with
+// (*deleter)(*owner); no copy is made and the response is left empty
+OSRMC_API void
+osrmc_table_response_detach_flatbuffer(osrmc_table_response_t response,
+                                       uint8_t** data,
+                                       size_t* size,
+                                       void** owner,
+                                       void (**deleter)(void*),
+                                       osrmc_error_t* error);
+// Table response hints (binary, one entry per coordinate of the request, from the first source or destination
+// waypoint snapped for it; size 0 for coordinates that are neither): count and total size, then the concatenated
+// hints with per-coordinate sizes for osrmc_params_set_hints_binary. Stream block responses report the hints of
+// their own sources and destinations the same way.
+OSRMC_API void
+osrmc_table_response_get_hint_count(osrmc_table_response_t response,
+                                    size_t* out_count,
+                                    size_t* out_size,
+                                    osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_response_get_hints(osrmc_table_response_t response,
+                               uint8_t* out_data,
+                               size_t capacity,
+                               size_t* out_sizes,
+                               size_t count,
+                               osrmc_error_t* error);
+// Table response matrices, written straight into a caller buffer of rows x cols values (sources x destinations)
+// in the given order. Unreachable pairs are written as NaN. OSRM stores them as 0, so they are told apart from
+// zero-cost pairs by the waypoints: a 0 cell is unreachable when its source and destination snapped to different
+// locations. Responses of skip_waypoints requests have no waypoints, so unreachable pairs stay 0 there. Fails when
+// the response has no such annotation or a different size.
+OSRMC_API void
+osrmc_table_response_get_durations(osrmc_table_response_t response,
+                                   double* out,
+                                   size_t rows,
+                                   size_t cols,
+                                   matrix_order_t order,
+                                   osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_response_get_distances(osrmc_table_response_t response,
+                                   double* out,
+                                   size_t rows,
+                                   size_t cols,
+                                   matrix_order_t order,
+                                   osrmc_error_t* error);
+// Compact matrices: float32 at half the size, with NaN for non-finite cells, the precision the response stores
+OSRMC_API void
+osrmc_table_response_get_durations_float32(osrmc_table_response_t response,
+                                           float* out,
+                                           size_t rows,
+                                           size_t cols,
+                                           matrix_order_t order,
+                                           osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_response_get_distances_float32(osrmc_table_response_t response,
+                                           float* out,
+                                           size_t rows,
+                                           size_t cols,
+                                           matrix_order_t order,
+                                           osrmc_error_t* error);
+// Quantized matrices: round(value * scale) as uint32 (e.g. scale 10 for decisecond durations), saturating at
+// OSRMC_MATRIX_UNREACHABLE - 1. Pairs the float matrices write as NaN become OSRMC_MATRIX_UNREACHABLE.
+OSRMC_API void
+osrmc_table_response_get_durations_uint32(osrmc_table_response_t response,
+                                          uint32_t* out,
+                                          size_t rows,
+                                          size_t cols,
+                                          matrix_order_t order,
+                                          double scale,
+                                          osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_response_get_distances_uint32(osrmc_table_response_t response,
+                                          uint32_t* out,
+                                          size_t rows,
+                                          size_t cols,
+                                          matrix_order_t order,
+                                          double scale,
+                                          osrmc_error_t* error);
 
 /* Match */
 
@@ -460,6 +936,17 @@ OSRMC_API osrmc_match_params_t
 osrmc_match_params_construct(osrmc_error_t* error);
 OSRMC_API void
 osrmc_match_params_destruct(osrmc_match_params_t params);
+// Match parameter reset (back to defaults, keeps allocated capacity for reuse)
+OSRMC_API void
+osrmc_match_params_reset(osrmc_match_params_t params, osrmc_error_t* error);
+// Match parameter clone (deep copy, destroy with osrmc_match_params_destruct)
+OSRMC_API osrmc_match_params_t
+osrmc_match_params_clone(osrmc_match_params_t params, osrmc_error_t* error);
+// Match parameter template (copies all options, clears per-coordinate data and index lists keeping capacity)
+OSRMC_API void
+osrmc_match_params_apply_template(osrmc_match_params_t params,
+                                  osrmc_match_params_t template_params,
+                                  osrmc_error_t* error);
 // Match parameter setters and getters
 OSRMC_API void
 osrmc_match_params_set_steps(osrmc_match_params_t params, int on, osrmc_error_t* error);
@@ -502,6 +989,12 @@ OSRMC_API void
 osrmc_match_params_get_waypoint(osrmc_match_params_t params, size_t index, size_t* out_index, osrmc_error_t* error);
 OSRMC_API void
 osrmc_match_params_clear_waypoints(osrmc_match_params_t params, osrmc_error_t* error);
+// Replace all waypoints with an index list
+OSRMC_API void
+osrmc_match_params_set_waypoints(osrmc_match_params_t params,
+                                 const size_t* indices,
+                                 size_t count,
+                                 osrmc_error_t* error);
 OSRMC_API void
 osrmc_match_params_add_timestamp(osrmc_match_params_t params, unsigned timestamp, osrmc_error_t* error);
 OSRMC_API void
@@ -511,6 +1004,17 @@ osrmc_match_params_get_timestamp(osrmc_match_params_t params,
                                  size_t index,
                                  unsigned* out_timestamp,
                                  osrmc_error_t* error);
+// Replace all timestamps; the epoch variant takes 64 bit seconds and rejects values outside the 32 bit unsigned range
+OSRMC_API void
+osrmc_match_params_set_timestamps(osrmc_match_params_t params,
+                                  const unsigned* timestamps,
+                                  size_t count,
+                                  osrmc_error_t* error);
+OSRMC_API void
+osrmc_match_params_set_timestamps_epoch(osrmc_match_params_t params,
+                                        const int64_t* epoch_seconds,
+                                        size_t count,
+                                        osrmc_error_t* error);
 OSRMC_API void
 osrmc_match_params_set_gaps(osrmc_match_params_t params, match_gaps_type_t gaps, osrmc_error_t* error);
 OSRMC_API void
@@ -525,6 +1029,31 @@ OSRMC_API osrmc_match_response_t
 osrmc_match(osrmc_osrm_t osrm, osrmc_match_params_t params, osrmc_error_t* error);
 OSRMC_API void
 osrmc_match_response_destruct(osrmc_match_response_t response);
+// Match batch (runs the requests on the worker pool; responses and errors, if given, are per item)
+OSRMC_API void
+osrmc_match_batch(osrmc_osrm_t osrm,
+                  const osrmc_match_params_t* params,
+                  size_t n,
+                  osrmc_match_response_t* out,
+                  osrmc_error_t* errors);
+// Match traces: one match request per trace of columnar input, run on the worker pool longest trace first. Rows
+// of a trace are contiguous and a new trace starts wherever the trace id changes. Each trace gets the options of
+// `template_params` (NULL = defaults) and the coordinates and, if given, epoch-second timestamps of its rows;
+// the template's deadline and cancellation token apply to all traces, its tenant and response allocator to each
+// trace. out[i] and errors[i] (if given) belong to the i-th trace. Returns the trace count, or 0 with `error` set
+// if the input is invalid or has more than `capacity` traces.
+OSRMC_API size_t
+osrmc_match_traces(osrmc_osrm_t osrm,
+                   osrmc_match_params_t template_params,
+                   const uint64_t* trace_ids,
+                   const double* longitudes,
+                   const double* latitudes,
+                   const int64_t* timestamps,
+                   size_t count,
+                   osrmc_match_response_t* out,
+                   osrmc_error_t* errors,
+                   size_t capacity,
+                   osrmc_error_t* error);
 // Match response getters (transfer ownership to caller)
 OSRMC_API void
 osrmc_match_response_transfer_flatbuffer(osrmc_match_response_t response,
@@ -532,6 +1061,15 @@ osrmc_match_response_transfer_flatbuffer(osrmc_match_response_t response,
                                          size_t* size,
                                          void (**deleter)(void*),
                                          osrmc_error_t* error);
+// Match response zero-copy transfer: *data points into the response buffer owned by *owner, release it with
+// (*deleter)(*owner); no copy is made and the response is left empty
+OSRMC_API void
+osrmc_match_response_detach_flatbuffer(osrmc_match_response_t response,
+                                       uint8_t** data,
+                                       size_t* size,
+                                       void** owner,
+                                       void (**deleter)(void*),
+                                       osrmc_error_t* error);
 
 /* Trip */
 
@@ -540,6 +1078,17 @@ OSRMC_API osrmc_trip_params_t
 osrmc_trip_params_construct(osrmc_error_t* error);
 OSRMC_API void
 osrmc_trip_params_destruct(osrmc_trip_params_t params);
+// Trip parameter reset (back to defaults, keeps allocated capacity for reuse)
+OSRMC_API void
+osrmc_trip_params_reset(osrmc_trip_params_t params, osrmc_error_t* error);
+// Trip parameter clone (deep copy, destroy with osrmc_trip_params_destruct)
+OSRMC_API osrmc_trip_params_t
+osrmc_trip_params_clone(osrmc_trip_params_t params, osrmc_error_t* error);
+// Trip parameter template (copies all options, clears per-coordinate data and index lists keeping capacity)
+OSRMC_API void
+osrmc_trip_params_apply_template(osrmc_trip_params_t params,
+                                 osrmc_trip_params_t template_params,
+                                 osrmc_error_t* error);
 // Trip parameter setters and getters
 OSRMC_API void
 osrmc_trip_params_set_roundtrip(osrmc_trip_params_t params, int on, osrmc_error_t* error);
@@ -595,12 +1144,25 @@ OSRMC_API void
 osrmc_trip_params_get_waypoint_count(osrmc_trip_params_t params, size_t* out_count, osrmc_error_t* error);
 OSRMC_API void
 osrmc_trip_params_get_waypoint(osrmc_trip_params_t params, size_t index, size_t* out_index, osrmc_error_t* error);
+// Replace all waypoints with an index list
+OSRMC_API void
+osrmc_trip_params_set_waypoints(osrmc_trip_params_t params,
+                                const size_t* indices,
+                                size_t count,
+                                osrmc_error_t* error);
 
 // Trip response constructor and destructor
 OSRMC_API osrmc_trip_response_t
 osrmc_trip(osrmc_osrm_t osrm, osrmc_trip_params_t params, osrmc_error_t* error);
 OSRMC_API void
 osrmc_trip_response_destruct(osrmc_trip_response_t response);
+// Trip batch (runs the requests on the worker pool; responses and errors, if given, are per item)
+OSRMC_API void
+osrmc_trip_batch(osrmc_osrm_t osrm,
+                 const osrmc_trip_params_t* params,
+                 size_t n,
+                 osrmc_trip_response_t* out,
+                 osrmc_error_t* errors);
 // Trip response getters (transfer ownership to caller)
 OSRMC_API void
 osrmc_trip_response_transfer_flatbuffer(osrmc_trip_response_t response,
@@ -608,6 +1170,15 @@ osrmc_trip_response_transfer_flatbuffer(osrmc_trip_response_t response,
                                         size_t* size,
                                         void (**deleter)(void*),
                                         osrmc_error_t* error);
+// Trip response zero-copy transfer: *data points into the response buffer owned by *owner, release it with
+// (*deleter)(*owner); no copy is made and the response is left empty
+OSRMC_API void
+osrmc_trip_response_detach_flatbuffer(osrmc_trip_response_t response,
+                                      uint8_t** data,
+                                      size_t* size,
+                                      void** owner,
+                                      void (**deleter)(void*),
+                                      osrmc_error_t* error);
 
 /* Tile */
 
@@ -616,6 +1187,12 @@ OSRMC_API osrmc_tile_params_t
 osrmc_tile_params_construct(osrmc_error_t* error);
 OSRMC_API void
 osrmc_tile_params_destruct(osrmc_tile_params_t params);
+// Tile parameter reset (back to defaults, keeps allocated capacity for reuse)
+OSRMC_API void
+osrmc_tile_params_reset(osrmc_tile_params_t params, osrmc_error_t* error);
+// Tile parameter clone (deep copy, destroy with osrmc_tile_params_destruct)
+OSRMC_API osrmc_tile_params_t
+osrmc_tile_params_clone(osrmc_tile_params_t params, osrmc_error_t* error);
 // Tile parameter setters and getters
 OSRMC_API void
 osrmc_tile_params_set_x(osrmc_tile_params_t params, unsigned x, osrmc_error_t* error);
@@ -635,12 +1212,146 @@ OSRMC_API osrmc_tile_response_t
 osrmc_tile(osrmc_osrm_t osrm, osrmc_tile_params_t params, osrmc_error_t* error);
 OSRMC_API void
 osrmc_tile_response_destruct(osrmc_tile_response_t response);
+// Tile batch (runs the requests on the worker pool; responses and errors, if given, are per item)
+OSRMC_API void
+osrmc_tile_batch(osrmc_osrm_t osrm,
+                 const osrmc_tile_params_t* params,
+                 size_t n,
+                 osrmc_tile_response_t* out,
+                 osrmc_error_t* errors);
 // Tile response getters
 OSRMC_API size_t
 osrmc_tile_response_size(osrmc_tile_response_t response, osrmc_error_t* error);
 OSRMC_API const char*
 osrmc_tile_response_data(osrmc_tile_response_t response, size_t* size, osrmc_error_t* error);
 
+/* Binary requests */
+
+// Decode a request encoded with the osrmc_request.fbs schema (installed next to this header) into a new params
+// object, replacing the individual setter calls; destroy the result with the matching params destructor
+OSRMC_API osrmc_nearest_params_t
+osrmc_nearest_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error);
+OSRMC_API osrmc_route_params_t
+osrmc_route_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error);
+OSRMC_API osrmc_table_params_t
+osrmc_table_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error);
+OSRMC_API osrmc_match_params_t
+osrmc_match_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error);
+OSRMC_API osrmc_trip_params_t
+osrmc_trip_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error);
+OSRMC_API osrmc_tile_params_t
+osrmc_tile_params_from_buffer(const uint8_t* data, size_t size, osrmc_error_t* error);
+
+/* URL requests */
+
+// Parse an osrm-routed request target (`/route/v1/driving/7.41,43.73;7.42,43.74?steps=true`, optionally with
+// scheme and host, percent-encoded or not) of `length` bytes into a new params object. The result is the
+// osrmc_<service>_params_t matching *out_service; destroy it with that service's params destructor.
+OSRMC_API void*
+osrmc_params_from_url(const char* url, size_t length, service_type_t* out_service, osrmc_error_t* error);
+
+/* Asynchronous requests */
+
+// Completed request: `response` is the osrmc_<service>_response_t of `service` or NULL with `error` set. The
+// caller owns both and destroys them with the matching destructors.
+typedef struct {
+  uint64_t ticket;
+  service_type_t service;
+  void* response;
+  osrmc_error_t error;
+} osrmc_completion_t;
+
+// Completion queue constructor and destructor (the destructor waits for in-flight requests and destroys
+// completions that were not reaped)
+OSRMC_API osrmc_completion_queue_t
+osrmc_completion_queue_construct(osrmc_error_t* error);
+OSRMC_API void
+osrmc_completion_queue_destruct(osrmc_completion_queue_t queue);
+// Completion queue getters: a descriptor that is readable while completions are queued (eventfd on Linux, pipe on
+// other POSIX systems) for registration with epoll/kqueue/libuv, and the number of requests in flight
+OSRMC_API void
+osrmc_completion_queue_get_fd(osrmc_completion_queue_t queue, int* out_fd, osrmc_error_t* error);
+OSRMC_API void
+osrmc_completion_queue_get_pending(osrmc_completion_queue_t queue, size_t* out_pending, osrmc_error_t* error);
+// Reap up to `max` completions: poll never blocks, wait blocks until one is available, nothing is in flight or
+// `timeout_ms` elapsed (negative waits indefinitely). Both return the number of completions written.
+OSRMC_API size_t
+osrmc_poll(osrmc_completion_queue_t queue, osrmc_completion_t* out, size_t max, osrmc_error_t* error);
+OSRMC_API size_t
+osrmc_wait(osrmc_completion_queue_t queue, osrmc_completion_t* out, size_t max, int timeout_ms, osrmc_error_t* error);
+// Non-blocking submission: returns a ticket (0 on error) that identifies the completion. Params are borrowed and
+// must stay alive and unmodified until the completion is reaped; the OSRM instance must outlive the queue's
+// in-flight requests.
+OSRMC_API uint64_t
+osrmc_nearest_submit(osrmc_osrm_t osrm,
+                     osrmc_nearest_params_t params,
+                     osrmc_completion_queue_t queue,
+                     osrmc_error_t* error);
+OSRMC_API uint64_t
+osrmc_route_submit(osrmc_osrm_t osrm,
+                   osrmc_route_params_t params,
+                   osrmc_completion_queue_t queue,
+                   osrmc_error_t* error);
+OSRMC_API uint64_t
+osrmc_table_submit(osrmc_osrm_t osrm,
+                   osrmc_table_params_t params,
+                   osrmc_completion_queue_t queue,
+                   osrmc_error_t* error);
+OSRMC_API uint64_t
+osrmc_match_submit(osrmc_osrm_t osrm,
+                   osrmc_match_params_t params,
+                   osrmc_completion_queue_t queue,
+                   osrmc_error_t* error);
+OSRMC_API uint64_t
+osrmc_trip_submit(osrmc_osrm_t osrm, osrmc_trip_params_t params, osrmc_completion_queue_t queue, osrmc_error_t* error);
+OSRMC_API uint64_t
+osrmc_tile_submit(osrmc_osrm_t osrm, osrmc_tile_params_t params, osrmc_completion_queue_t queue, osrmc_error_t* error);
+// Callback completion: the callback runs on a worker thread with either a response or an error, both owned by
+// the callback. Params are borrowed until then; errors that prevent submission are reported through `error`
+// and the callback is not called.
+typedef void (*osrmc_nearest_callback_t)(osrmc_nearest_response_t response, osrmc_error_t error, void* userdata);
+typedef void (*osrmc_route_callback_t)(osrmc_route_response_t response, osrmc_error_t error, void* userdata);
+typedef void (*osrmc_table_callback_t)(osrmc_table_response_t response, osrmc_error_t error, void* userdata);
+typedef void (*osrmc_match_callback_t)(osrmc_match_response_t response, osrmc_error_t error, void* userdata);
+typedef void (*osrmc_trip_callback_t)(osrmc_trip_response_t response, osrmc_error_t error, void* userdata);
+typedef void (*osrmc_tile_callback_t)(osrmc_tile_response_t response, osrmc_error_t error, void* userdata);
+OSRMC_API void
+osrmc_nearest_async(osrmc_osrm_t osrm,
+                    osrmc_nearest_params_t params,
+                    osrmc_nearest_callback_t callback,
+                    void* userdata,
+                    osrmc_error_t* error);
+OSRMC_API void
+osrmc_route_async(osrmc_osrm_t osrm,
+                  osrmc_route_params_t params,
+                  osrmc_route_callback_t callback,
+                  void* userdata,
+                  osrmc_error_t* error);
+OSRMC_API void
+osrmc_table_async(osrmc_osrm_t osrm,
+                  osrmc_table_params_t params,
+                  osrmc_table_callback_t callback,
+                  void* userdata,
+                  osrmc_error_t* error);
+OSRMC_API void
+osrmc_match_async(osrmc_osrm_t osrm,
+                  osrmc_match_params_t params,
+                  osrmc_match_callback_t callback,
+                  void* userdata,
+                  osrmc_error_t* error);
+OSRMC_API void
+osrmc_trip_async(osrmc_osrm_t osrm,
+                 osrmc_trip_params_t params,
+                 osrmc_trip_callback_t callback,
+                 void* userdata,
+                 osrmc_error_t* error);
+OSRMC_API void
+osrmc_tile_async(osrmc_osrm_t osrm,
+                 osrmc_tile_params_t params,
+                 osrmc_tile_callback_t callback,
+                 void* userdata,
+                 osrmc_error_t* error);
+
 #ifdef __cplusplus
 }
 #endif